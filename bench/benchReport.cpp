@@ -0,0 +1,46 @@
+#include "benchReport.h"
+
+#include "graph/outputBuffer.h"
+
+#include <fmt/format.h>
+
+#include <iterator>
+
+namespace fbxViz::bench {
+
+void BenchReport::add(BenchResult result)
+{
+    m_results.push_back(std::move(result));
+}
+
+bool BenchReport::write(std::string_view fileName) const
+{
+    OutputBuffer out(fileName);
+    if (!out.isOpen()) {
+        return false;
+    }
+
+    // names and parameter keys are plain identifiers, nothing to escape
+    out.write("{\n  \"results\": [\n");
+    for (std::size_t i = 0; i < m_results.size(); ++i) {
+        const auto& result = m_results[i];
+
+        out.format("    {{ \"suite\": \"{}\", \"name\": \"{}\", \"parameters\": {{", result.suite, result.name);
+        for (std::size_t p = 0; p < result.parameters.size(); ++p) {
+            out.format("{}\"{}\": {}", p == 0 ? " " : ", ", result.parameters[p].first, result.parameters[p].second);
+        }
+
+        const auto perSecond = [&](double amount) { return result.seconds > 0.0 ? amount / result.seconds : 0.0; };
+        out.format(" }}, \"seconds\": {:.6f}, \"items\": {}, \"itemsPerSecond\": {:.1f}, \"bytes\": {}, \"bytesPerSecond\": {:.1f} }}{}\n",
+                   result.seconds, result.items, perSecond(static_cast<double>(result.items)),
+                   result.bytes, perSecond(static_cast<double>(result.bytes)),
+                   i + 1 < m_results.size() ? "," : "");
+    }
+    out.write("  ]\n}\n");
+    out.close();
+
+    fmt::print("Wrote results to {}\n", out.fileName());
+    return true;
+}
+
+} // namespace fbxViz::bench
@@ -0,0 +1,265 @@
+#include "graphBench.h"
+
+#include "curveInfo.h"
+#include "curveSampler.h"
+#include "graph/compression.h"
+#include "graph/graph.h"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cmath>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace {
+
+    constexpr fbxViz::NodeId FanOut = 4;
+
+    // a sine with cubic keys, one key per frame
+    fbxViz::CurveSnapshot makeCurve(std::size_t keyCount)
+    {
+        constexpr std::int64_t TicksPerFrame = 1539538600;
+
+        const auto flags = fbxViz::CurveSnapshot::packFlags(fbxViz::KeyInterpolation::Cubic, fbxViz::KeyTangentMode::Auto,
+                                                            fbxViz::KeyTangentWeight::None, fbxViz::KeyConstantMode::Standard);
+
+        fbxViz::CurveSnapshot curve;
+        curve.reserve(keyCount);
+        for (std::size_t i = 0; i < keyCount; ++i) {
+            const auto phase = static_cast<float>(i) * 0.1f;
+            curve.addKey(static_cast<std::int64_t>(i) * TicksPerFrame, std::sin(phase), std::cos(phase), std::cos(phase), flags);
+        }
+
+        return curve;
+    }
+
+    void printResult(const fbxViz::bench::BenchResult& result)
+    {
+        fmt::print("{:>24} {:>10} {:>12.4f} {:>14.0f}\n", result.name, result.items, result.seconds,
+                   result.seconds > 0.0 ? result.items / result.seconds : 0.0);
+    }
+
+    void addResult(fbxViz::bench::BenchReport& report, fbxViz::bench::BenchResult result)
+    {
+        printResult(result);
+        report.add(std::move(result));
+    }
+
+    void benchGraph(std::size_t nodeCount, const std::string& fileName, fbxViz::bench::BenchReport& report)
+    {
+        const std::vector<std::pair<std::string, double>> parameters{ { "nodes", double(nodeCount) } };
+
+        // nodes only view their strings
+        std::vector<std::string> names;
+        std::vector<fbxViz::Node> nodes;
+        names.reserve(nodeCount);
+        nodes.reserve(nodeCount);
+        for (std::size_t i = 0; i < nodeCount; ++i) {
+            nodes.emplace_back(names.emplace_back(fmt::format("node_{}", i)));
+            nodes.back().setType(i % 4 == 0 ? "mesh" : "null");
+        }
+
+        fbxViz::DGraph graph("bench");
+
+        auto seconds = fbxViz::bench::timeIt([&] {
+            for (std::size_t i = 0; i < nodeCount; ++i) {
+                graph.addNode(fbxViz::NodeKey(i + 1), nodes[i]);
+            }
+        });
+        addResult(report, { "graph", "addNode", parameters, seconds, nodeCount, 0 });
+
+        // every key is known now, this is the lookup of an instanced node
+        seconds = fbxViz::bench::timeIt([&] {
+            for (std::size_t i = 0; i < nodeCount; ++i) {
+                graph.addNode(fbxViz::NodeKey(i + 1), nodes[i]);
+            }
+        });
+        addResult(report, { "graph", "addNode_interned", parameters, seconds, nodeCount, 0 });
+
+        const auto edgeCount = nodeCount - 1;
+        seconds = fbxViz::bench::timeIt([&] {
+            for (fbxViz::NodeId id = 1; id < nodeCount; ++id) {
+                graph.addEdge((id - 1) / FanOut, id);
+            }
+        });
+        addResult(report, { "graph", "addEdge", parameters, seconds, edgeCount, 0 });
+
+        seconds = fbxViz::bench::timeIt([&] {
+            for (fbxViz::NodeId id = 1; id < nodeCount; ++id) {
+                graph.addEdge((id - 1) / FanOut, id);
+            }
+        });
+        addResult(report, { "graph", "addEdge_duplicate", parameters, seconds, edgeCount, 0 });
+
+        seconds = fbxViz::bench::timeIt([&] { graph.freeze(); });
+        addResult(report, { "graph", "freeze", parameters, seconds, nodeCount, 0 });
+
+        seconds = fbxViz::bench::timeIt([&] { graph.dumpDag(fileName); });
+        addResult(report, { "graph", "dumpDag", parameters, seconds, nodeCount, std::filesystem::file_size(fileName) });
+
+        // half of the nodes carry a curve label, like an animation stack
+        const auto curveInfo = fbxViz::getCurveAnimKeyInfo(makeCurve(8), fbxViz::CurveDetail{});
+        for (fbxViz::NodeId id = 0; id < nodeCount; id += 2) {
+            graph.setDataInfo(id, curveInfo);
+        }
+
+        seconds = fbxViz::bench::timeIt([&] { graph.dumpAnimStack(fileName); });
+        addResult(report, { "graph", "dumpAnimStack", parameters, seconds, nodeCount, std::filesystem::file_size(fileName) });
+
+        struct Format
+        {
+            const char* name;
+            fbxViz::GraphFormat format;
+        };
+
+        const Format formats[] = {
+            { "dumpAnimStack_json", fbxViz::GraphFormat::Json },
+            { "dumpAnimStack_graphml", fbxViz::GraphFormat::GraphMl },
+            { "dumpAnimStack_edgelist", fbxViz::GraphFormat::EdgeList }
+        };
+
+        for (const auto& format : formats) {
+            seconds = fbxViz::bench::timeIt([&] { graph.dumpAnimStack(fileName, format.format); });
+            addResult(report, { "graph", format.name, parameters, seconds, nodeCount, std::filesystem::file_size(fileName) });
+        }
+
+        // the compression runs on its own thread, overlapped with the formatting
+        struct Compressed
+        {
+            const char* name;
+            fbxViz::Compression compression;
+        };
+
+        const Compressed compressions[] = {
+            { "dumpAnimStack_gzip", fbxViz::Compression::Gzip },
+            { "dumpAnimStack_zstd", fbxViz::Compression::Zstd }
+        };
+
+        for (const auto& compressed : compressions) {
+            if (!fbxViz::isCompressionAvailable(compressed.compression)) {
+                continue;
+            }
+
+            const auto compressedFile = fileName + std::string(fbxViz::compressionExtension(compressed.compression));
+            seconds = fbxViz::bench::timeIt([&] { graph.dumpAnimStack(compressedFile); });
+            addResult(report, { "graph", compressed.name, parameters, seconds, nodeCount, std::filesystem::file_size(compressedFile) });
+            std::filesystem::remove(compressedFile);
+        }
+    }
+
+    void benchCurveInfo(std::size_t keyCount, fbxViz::bench::BenchReport& report)
+    {
+        // about a million keys per measurement
+        const auto curveCount = std::max<std::size_t>(1, 1000000 / keyCount);
+        const auto curve = makeCurve(keyCount);
+
+        struct Mode
+        {
+            const char* name;
+            fbxViz::CurveDetail detail;
+        };
+
+        const Mode modes[] = {
+            { "curveInfo_full", { fbxViz::CurveDetail::Mode::Full, 0 } },
+            { "curveInfo_summary", { fbxViz::CurveDetail::Mode::Summary, 0 } },
+            { "curveInfo_rows16", { fbxViz::CurveDetail::Mode::Rows, 16 } }
+        };
+
+        for (const auto& mode : modes) {
+            std::uint64_t bytes = 0;
+            const auto seconds = fbxViz::bench::timeIt([&] {
+                for (std::size_t i = 0; i < curveCount; ++i) {
+                    bytes += fbxViz::getCurveAnimKeyInfo(curve, mode.detail).size();
+                }
+            });
+
+            addResult(report, { "curveInfo", mode.name, { { "keys", double(keyCount) }, { "curves", double(curveCount) } },
+                                seconds, curveCount * keyCount, bytes });
+        }
+    }
+
+    // the curves of makeCurve() sampled at four frames per key: a key search
+    // per frame like an uncached evaluation, the batched key walk, and the
+    // whole table written on every core
+    void benchCurveSampling(std::size_t keyCount, const std::string& fileName, fbxViz::bench::BenchReport& report)
+    {
+        constexpr std::size_t CurveCount = 256;
+        const auto curve = makeCurve(keyCount);
+
+        fbxViz::SampleGrid grid;
+        grid.start = curve.times.front();
+        grid.stop = curve.times.back();
+        grid.frameRate = 120.0;
+
+        const auto frameCount = grid.frameCount();
+        std::vector<std::int64_t> times(frameCount);
+        for (std::size_t frame = 0; frame < frameCount; ++frame) {
+            times[frame] = grid.time(frame);
+        }
+
+        const std::vector<std::pair<std::string, double>> parameters{ { "keys", double(keyCount) }, { "curves", double(CurveCount) }, { "frames", double(frameCount) } };
+        const auto items = CurveCount * frameCount;
+        std::vector<float> values(frameCount);
+
+        auto seconds = fbxViz::bench::timeIt([&] {
+            for (std::size_t i = 0; i < CurveCount; ++i) {
+                for (std::size_t frame = 0; frame < frameCount; ++frame) {
+                    const auto next = std::upper_bound(curve.times.begin(), curve.times.end(), times[frame]);
+                    std::size_t key = next == curve.times.begin() ? 0 : static_cast<std::size_t>(next - curve.times.begin()) - 1;
+                    fbxViz::sampleCurve(curve, &times[frame], 1, &values[frame], key);
+                }
+            }
+        });
+        addResult(report, { "curveSampling", "sample_search", parameters, seconds, items, 0 });
+
+        seconds = fbxViz::bench::timeIt([&] {
+            for (std::size_t i = 0; i < CurveCount; ++i) {
+                std::size_t key = 0;
+                fbxViz::sampleCurve(curve, times.data(), frameCount, values.data(), key);
+            }
+        });
+        addResult(report, { "curveSampling", "sample_batched", parameters, seconds, items, 0 });
+
+        const std::vector<fbxViz::SampleChannel> channels(CurveCount, { "curve", &curve });
+        const std::vector<fbxViz::SampleTable> tables{ { grid, channels } };
+        seconds = fbxViz::bench::timeIt([&] { fbxViz::writeSampleTables(fileName, fbxViz::SampleFormat::Binary, tables, 0); });
+        addResult(report, { "curveSampling", "sample_table_binary", parameters, seconds, items, std::filesystem::file_size(fileName) });
+
+        seconds = fbxViz::bench::timeIt([&] { fbxViz::writeSampleTables(fileName, fbxViz::SampleFormat::Csv, tables, 0); });
+        addResult(report, { "curveSampling", "sample_table_csv", parameters, seconds, items, std::filesystem::file_size(fileName) });
+    }
+
+} // namespace
+
+namespace fbxViz::bench {
+
+void runGraphBench(std::size_t maxNodes, std::string_view outputDir, BenchReport& report)
+{
+    std::filesystem::create_directories(outputDir);
+    const auto fileName = (std::filesystem::path(outputDir) / "graph.dot").string();
+
+    fmt::print("{:>24} {:>10} {:>12} {:>14}\n", "benchmark", "items", "seconds", "items/s");
+
+    for (std::size_t nodeCount = 1000; nodeCount <= maxNodes; nodeCount *= 10) {
+        fmt::print("nodes {}\n", nodeCount);
+        benchGraph(nodeCount, fileName, report);
+    }
+
+    for (std::size_t keyCount : { 8, 64, 1024 }) {
+        fmt::print("keys per curve {}\n", keyCount);
+        benchCurveInfo(keyCount, report);
+    }
+
+    const auto samplesFile = (std::filesystem::path(outputDir) / "graph.samples").string();
+    for (std::size_t keyCount : { 64, 1024 }) {
+        fmt::print("sampled keys per curve {}\n", keyCount);
+        benchCurveSampling(keyCount, samplesFile, report);
+    }
+
+    std::filesystem::remove(fileName);
+    std::filesystem::remove(samplesFile);
+}
+
+} // namespace fbxViz::bench
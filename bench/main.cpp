@@ -0,0 +1,136 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "benchReport.h"
+#include "graphBench.h"
+#include "pipelineBench.h"
+#include "serializerBench.h"
+
+#include <fmt/core.h>
+
+#include <cstdlib>
+#include <filesystem>
+#include <string>
+#include <string_view>
+
+namespace {
+
+    void usage(std::string_view program)
+    {
+        fmt::print("Usage: {} [options]\n"
+                   "Options:\n"
+                   "  --suite=NAME       all ( default ), serializer, graph or pipeline\n"
+                   "  --max-nodes=N      largest synthetic graph, the sweep goes 10^3, 10^4, ... N ( default 10^7 )\n"
+                   "  --output-dir=DIR   scratch directory for the generated files ( default bench_output )\n"
+                   "  --json=FILE        where the results go ( default DIR/bench.json )\n"
+                   "Generated scene of the pipeline suite:\n"
+                   "  --depth=N          levels below the root ( default 8 )\n"
+                   "  --fan-out=N        children per node ( default 4 )\n"
+                   "  --nodes=N          node count ( default 10000 )\n"
+                   "  --layers=N         animation layers ( default 2 )\n"
+                   "  --animated-every=N animate every N-th node ( default 2 )\n"
+                   "  --keys=N           keys per curve ( default 48 )\n",
+                   program);
+    }
+
+    // matches "--name=value" and returns the value
+    bool matchValue(std::string_view arg, std::string_view name, std::string_view& value)
+    {
+        if (arg.size() > name.size() && arg.substr(0, name.size()) == name && arg[name.size()] == '=') {
+            value = arg.substr(name.size() + 1);
+            return true;
+        }
+
+        return false;
+    }
+
+    unsigned toUnsigned(std::string_view value)
+    {
+        return static_cast<unsigned>(std::strtoul(std::string(value).c_str(), nullptr, 10));
+    }
+
+} // namespace
+
+int main(int argc, char** argv)
+{
+    std::size_t maxNodes = 10000000;
+    std::string outputDir = "bench_output";
+    std::string suite = "all";
+    std::string jsonFile;
+    fbxViz::bench::SceneShape shape;
+
+    for (auto i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        std::string_view value;
+
+        if (matchValue(arg, "--max-nodes", value)) {
+            maxNodes = std::strtoull(std::string(value).c_str(), nullptr, 10);
+        } else if (matchValue(arg, "--output-dir", value)) {
+            outputDir = value;
+        } else if (matchValue(arg, "--suite", value)) {
+            suite = value;
+        } else if (matchValue(arg, "--json", value)) {
+            jsonFile = value;
+        } else if (matchValue(arg, "--depth", value)) {
+            shape.depth = toUnsigned(value);
+        } else if (matchValue(arg, "--fan-out", value)) {
+            shape.fanOut = toUnsigned(value);
+        } else if (matchValue(arg, "--nodes", value)) {
+            shape.nodeCount = toUnsigned(value);
+        } else if (matchValue(arg, "--layers", value)) {
+            shape.layers = toUnsigned(value);
+        } else if (matchValue(arg, "--animated-every", value)) {
+            shape.animatedEvery = toUnsigned(value);
+        } else if (matchValue(arg, "--keys", value)) {
+            shape.keysPerCurve = toUnsigned(value);
+        } else {
+            usage(argv[0]);
+            return 1;
+        }
+    }
+
+    if (suite != "all" && suite != "serializer" && suite != "graph" && suite != "pipeline") {
+        usage(argv[0]);
+        return 1;
+    }
+
+    fbxViz::bench::BenchReport report;
+
+    if (suite == "all" || suite == "serializer") {
+        fbxViz::bench::runSerializerBench(maxNodes, outputDir, report);
+    }
+
+    if (suite == "all" || suite == "graph") {
+        fbxViz::bench::runGraphBench(maxNodes, outputDir, report);
+    }
+
+    if (suite == "all" || suite == "pipeline") {
+        fbxViz::bench::runPipelineBench(shape, outputDir, report);
+    }
+
+    if (jsonFile.empty()) {
+        jsonFile = (std::filesystem::path(outputDir) / "bench.json").string();
+    }
+
+    return report.write(jsonFile) ? 0 : 1;
+}
@@ -0,0 +1,91 @@
+#include "pipelineBench.h"
+
+#include "common.h"
+#include "profile.h"
+
+#include <fmt/core.h>
+
+#include <filesystem>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace fbxViz::bench {
+
+void runPipelineBench(const SceneShape& shape, std::string_view outputDir, BenchReport& report)
+{
+    std::filesystem::create_directories(outputDir);
+    const std::filesystem::path dir(outputDir);
+    const auto sceneFile = (dir / "scene.fbx").string();
+
+    const std::vector<std::pair<std::string, double>> parameters{
+        { "depth", double(shape.depth) },
+        { "fanOut", double(shape.fanOut) },
+        { "nodes", double(shape.nodeCount) },
+        { "layers", double(shape.layers) },
+        { "animatedEvery", double(shape.animatedEvery) },
+        { "keysPerCurve", double(shape.keysPerCurve) }
+    };
+
+    // the shape may not reach nodeCount, the generated nodes are the items
+    std::size_t generated = 0;
+    const auto generateSeconds = timeIt([&] { generated = writeScene(sceneFile, shape); });
+    if (generated == 0) {
+        return;
+    }
+    report.add({ "pipeline", "generate", parameters, generateSeconds, generated, std::filesystem::file_size(sceneFile) });
+
+    Options options;
+    const auto outputFiles = outputFileNames((dir / "dag.dot").string(), (dir / "animstack.dot").string(), options);
+
+    Profile profile;
+    bool loaded = false;
+    const auto totalSeconds = timeIt([&] {
+        FbxManager* fbxManager{nullptr};
+        FbxScene* fbxScene{nullptr};
+        {
+            Profile::Scope scope(&profile, Phase::Initialize);
+            if (!initialize(fbxManager, fbxScene)) {
+                destroy(fbxManager);
+                return;
+            }
+        }
+
+        loaded = loadScene(fbxManager, fbxScene, sceneFile, options.validation, &profile);
+        if (loaded) {
+            std::unique_ptr<FlatScene> flatScene;
+            {
+                Profile::Scope scope(&profile, Phase::Flatten);
+                flatScene = std::make_unique<FlatScene>(fbxScene);
+            }
+
+            const auto root = findRootNode(*flatScene, options);
+            dumpSceneToFile(*flatScene, root, outputFiles[0], options, &profile);
+            dumpAnimStackToFile(*flatScene, root, outputFiles[1], options, &profile);
+        }
+
+        destroy(fbxManager);
+    });
+
+    if (!loaded) {
+        fmt::print("Error: unable to load {}!\n", sceneFile);
+        return;
+    }
+    profile.countFiles(outputFiles);
+
+    const auto nodes = profile.counter(Counter::Nodes);
+    for (auto phase : { Phase::Initialize, Phase::Import, Phase::Validate, Phase::Flatten, Phase::DagTraversal, Phase::AnimStackTraversal, Phase::Serialize }) {
+        report.add({ "pipeline", std::string(phaseName(phase)), parameters, profile.wallSeconds(phase), nodes, 0 });
+    }
+    report.add({ "pipeline", "total", parameters, totalSeconds, nodes, profile.counter(Counter::BytesWritten) });
+
+    fmt::print("{} nodes, {} curves, {} keys in {:.3f} s ( generated in {:.3f} s )\n",
+               nodes, profile.counter(Counter::Curves), profile.counter(Counter::Keys), totalSeconds, generateSeconds);
+
+    std::filesystem::remove(sceneFile);
+    for (const auto& fileName : outputFiles) {
+        std::filesystem::remove(fileName);
+    }
+}
+
+} // namespace fbxViz::bench
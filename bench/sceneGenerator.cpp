@@ -0,0 +1,139 @@
+#include "sceneGenerator.h"
+
+#include "common.h"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cmath>
+#include <string>
+#include <vector>
+
+namespace {
+
+    FbxNodeAttribute* createAttribute(FbxScene* pScene, std::size_t index, const std::string& name)
+    {
+        if (index % 4 == 0) {
+            // one quad
+            FbxMesh* mesh = FbxMesh::Create(pScene, (name + "_mesh").c_str());
+            mesh->InitControlPoints(4);
+            mesh->SetControlPointAt(FbxVector4(-1.0, 0.0, -1.0), 0);
+            mesh->SetControlPointAt(FbxVector4(1.0, 0.0, -1.0), 1);
+            mesh->SetControlPointAt(FbxVector4(1.0, 0.0, 1.0), 2);
+            mesh->SetControlPointAt(FbxVector4(-1.0, 0.0, 1.0), 3);
+            mesh->BeginPolygon();
+            for (auto vertex = 0; vertex < 4; ++vertex) {
+                mesh->AddPolygon(vertex);
+            }
+            mesh->EndPolygon();
+            return mesh;
+        }
+
+        if (index % 4 == 1) {
+            FbxSkeleton* skeleton = FbxSkeleton::Create(pScene, (name + "_joint").c_str());
+            skeleton->SetSkeletonType(FbxSkeleton::eLimbNode);
+            return skeleton;
+        }
+
+        return FbxNull::Create(pScene, (name + "_null").c_str());
+    }
+
+    // cubic keys on a sine, one per frame, shifted per curve so no two
+    // curves are the same
+    void animate(FbxAnimCurve* curve, unsigned keyCount, double phase)
+    {
+        curve->KeyModifyBegin();
+        for (unsigned key = 0; key < keyCount; ++key) {
+            FbxTime time;
+            time.SetSecondDouble(key / 24.0);
+
+            const auto index = curve->KeyAdd(time);
+            curve->KeySet(index, time, static_cast<float>(10.0 * std::sin(phase + key * 0.2)), FbxAnimCurveDef::eInterpolationCubic);
+        }
+        curve->KeyModifyEnd();
+    }
+
+    void animateNode(FbxNode* pNode, FbxAnimLayer* animLayer, unsigned keyCount, double phase)
+    {
+        const char* components[] = { FBXSDK_CURVENODE_COMPONENT_X, FBXSDK_CURVENODE_COMPONENT_Y, FBXSDK_CURVENODE_COMPONENT_Z };
+
+        for (auto i = 0; i < 3; ++i) {
+            animate(pNode->LclTranslation.GetCurve(animLayer, components[i], true), keyCount, phase + i);
+            animate(pNode->LclRotation.GetCurve(animLayer, components[i], true), keyCount, phase + i + 3);
+        }
+    }
+
+} // namespace
+
+namespace fbxViz::bench {
+
+std::size_t generateScene(FbxScene* pScene, const SceneShape& shape)
+{
+    struct Level
+    {
+        FbxNode* node;
+        unsigned depth;
+    };
+
+    std::vector<FbxNode*> nodes;
+    nodes.reserve(shape.nodeCount);
+
+    // breadth first, so every level is full before the next one starts
+    std::vector<Level> queue{ { pScene->GetRootNode(), 0 } };
+    for (std::size_t head = 0; head < queue.size() && nodes.size() < shape.nodeCount; ++head) {
+        const auto parent = queue[head];
+        if (parent.depth >= shape.depth) {
+            continue;
+        }
+
+        for (unsigned child = 0; child < shape.fanOut && nodes.size() < shape.nodeCount; ++child) {
+            const auto name = fmt::format("node_{}", nodes.size());
+
+            FbxNode* pNode = FbxNode::Create(pScene, name.c_str());
+            pNode->SetNodeAttribute(createAttribute(pScene, nodes.size(), name));
+            parent.node->AddChild(pNode);
+
+            nodes.push_back(pNode);
+            queue.push_back({ pNode, parent.depth + 1 });
+        }
+    }
+
+    if (shape.layers > 0 && shape.keysPerCurve > 0) {
+        FbxAnimStack* animStack = FbxAnimStack::Create(pScene, "stack");
+        for (unsigned layer = 0; layer < shape.layers; ++layer) {
+            FbxAnimLayer* animLayer = FbxAnimLayer::Create(pScene, fmt::format("layer_{}", layer).c_str());
+            animStack->AddMember(animLayer);
+
+            for (std::size_t i = 0; i < nodes.size(); i += std::max(1u, shape.animatedEvery)) {
+                animateNode(nodes[i], animLayer, shape.keysPerCurve, static_cast<double>(i + layer));
+            }
+        }
+    }
+
+    return nodes.size();
+}
+
+std::size_t writeScene(std::string_view fileName, const SceneShape& shape)
+{
+    FbxManager* fbxManager{nullptr};
+    FbxScene* fbxScene{nullptr};
+    if (!initialize(fbxManager, fbxScene)) {
+        destroy(fbxManager);
+        return 0;
+    }
+
+    const auto nodeCount = generateScene(fbxScene, shape);
+
+    const std::string name(fileName);
+    FbxExporter* exporter = FbxExporter::Create(fbxManager, "");
+    bool status = exporter->Initialize(name.c_str(), -1, fbxManager->GetIOSettings()) && exporter->Export(fbxScene);
+    if (!status) {
+        fmt::print("Error: unable to write {}!\n", fileName);
+    }
+    exporter->Destroy();
+
+    destroy(fbxManager);
+    return status ? nodeCount : 0;
+}
+
+} // namespace fbxViz::bench
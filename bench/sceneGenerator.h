@@ -0,0 +1,58 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <fbxsdk.h>
+
+#include <cstddef>
+#include <string_view>
+
+namespace fbxViz::bench {
+
+// shape of a generated scene. The hierarchy is filled breadth first with
+// fanOut children per node until nodeCount nodes or depth levels exist.
+struct SceneShape
+{
+    unsigned depth{8};
+    unsigned fanOut{4};
+    std::size_t nodeCount{10000};
+
+    // animation layers of the single stack, every animatedEvery-th node
+    // gets translation and rotation curves in each of them
+    unsigned layers{2};
+    unsigned animatedEvery{2};
+    unsigned keysPerCurve{48};
+};
+
+// builds the scene: nulls, skeleton joints and every fourth node a small
+// mesh. Returns the number of nodes below the root.
+std::size_t generateScene(FbxScene* pScene, const SceneShape& shape);
+
+// generates a scene with its own manager and writes it as binary FBX.
+// Returns the number of nodes below the root, which falls short of
+// shape.nodeCount when depth and fan out cannot reach it, or 0 if the scene
+// could not be written.
+std::size_t writeScene(std::string_view fileName, const SceneShape& shape);
+
+} // namespace fbxViz::bench
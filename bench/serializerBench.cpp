@@ -0,0 +1,162 @@
+#include "serializerBench.h"
+
+#include "graph/graph.h"
+#include "graph/nodeData.h"
+
+#include <fmt/core.h>
+
+#include <filesystem>
+#include <fstream>
+#include <string>
+
+namespace {
+
+    constexpr fbxViz::NodeId FanOut = 4;
+
+    // rows shaped like the ones getCurveAnimKeyInfo() produces
+    std::string makeKeyRows(int keyCount)
+    {
+        std::string rows;
+        fbxViz::NodeDataBuilder builder(rows);
+        builder.row().field("Key counts", keyCount);
+        for (auto i = 0; i < keyCount; ++i) {
+            builder.row()
+                .field("Key Time", i)
+                .field("Key Value", i * 0.5)
+                .field("InterpolationType", "cubic");
+        }
+        return rows;
+    }
+
+    // a tree with a fixed fan-out, a mesh every fourth node and key rows on
+    // every other node when the data info is wanted
+    void buildGraph(fbxViz::DGraph& graph, std::size_t nodeCount, bool withDataInfo)
+    {
+        const auto keyRows = makeKeyRows(8);
+
+        for (std::size_t i = 0; i < nodeCount; ++i) {
+            const auto name = fmt::format("node_{}", i);
+            fbxViz::Node node(name);
+            node.setType(i % 4 == 0 ? "mesh" : "null");
+            if (withDataInfo && i % 2 == 0) {
+                node.setDataInfo(keyRows);
+            }
+
+            auto nodeId = graph.addNode(fbxViz::NodeKey(i + 1), node);
+            if (nodeId > 0) {
+                graph.addEdge((nodeId - 1) / FanOut, nodeId);
+            }
+        }
+
+        graph.freeze();
+    }
+
+    // the std::ostream writer DGraph used before OutputBuffer
+    void writeWithOstream(const fbxViz::DGraph& graph, const std::string& fileName, bool withDataInfo)
+    {
+        std::ofstream out(fileName);
+
+        out << "digraph " << graph.graphName << " {\n\n";
+
+        const auto& nodes = graph.getNodes();
+        for (fbxViz::NodeId id = 0; id < nodes.size(); ++id) {
+            const auto& node = nodes[id];
+
+            std::string_view shape = "box";
+            if (!withDataInfo) {
+                shape = "ellipse";
+                if (node.getType().empty()) {
+                    shape = "box";
+                } else if (node.getType() == "mesh") {
+                    shape = "diamond";
+                }
+            }
+
+            out << 'n' << id << " [" << '\n'
+                << "  label = " << "<" << '\n'
+                << "  <table border='0' cellborder='0' cellspacing='1'>" << '\n'
+                << "  <tr><td align=\"center\"><b>" << node.getName() << "</b></td></tr>" << '\n'
+                << "  <tr><td align=\"center\">" << "(" << node.getType() << ")"<< "</td></tr>" << '\n';
+            if (withDataInfo) {
+                fbxViz::NodeDataCursor cursor(node.getDataInfo());
+                fbxViz::NodeDataField field;
+                while (cursor.nextRow()) {
+                    out << "<tr><td align='left'>";
+                    std::string_view separator;
+                    while (cursor.nextField(field)) {
+                        out << separator << field.name << "= <font color='red'><b>" << field.value << "</b></font>";
+                        separator = " , ";
+                    }
+                    out << "</td></tr>\n";
+                }
+            }
+            out << "  </table>> " << '\n'
+                << "  shape = " << shape << '\n'
+                << "  fillcolor = \"#40e0d0\"" << '\n'
+                << "  style=\"filled\"" << '\n'
+                << "]\n\n";
+        }
+
+        for (fbxViz::NodeId src = 0; src < nodes.size(); ++src) {
+            for (auto dest : graph.children(src)) {
+                out << 'n' << src << " -> n" << dest << ";\n";
+            }
+        }
+
+        out << "\n}\n";
+    }
+
+    double megaBytesPerSecond(const std::string& fileName, double seconds)
+    {
+        auto bytes = static_cast<double>(std::filesystem::file_size(fileName));
+        return seconds > 0.0 ? bytes / (1024.0 * 1024.0) / seconds : 0.0;
+    }
+
+} // namespace
+
+namespace fbxViz::bench {
+
+void runSerializerBench(std::size_t maxNodes, std::string_view outputDir, BenchReport& report)
+{
+    std::filesystem::create_directories(outputDir);
+
+    const auto ostreamFile = (std::filesystem::path(outputDir) / "ostream.dot").string();
+    const auto bufferedFile = (std::filesystem::path(outputDir) / "buffered.dot").string();
+
+    fmt::print("{:>10} {:>10} {:>12} {:>12} {:>12} {:>12} {:>8}\n",
+               "nodes", "style", "ostream s", "ostream MB/s", "buffered s", "buffered MB/s", "speedup");
+
+    for (std::size_t nodeCount = 1000; nodeCount <= maxNodes; nodeCount *= 10) {
+        for (auto withDataInfo : { false, true }) {
+
+            DGraph graph("bench");
+            buildGraph(graph, nodeCount, withDataInfo);
+
+            auto ostreamTime = timeIt([&] { writeWithOstream(graph, ostreamFile, withDataInfo); });
+            auto bufferedTime = timeIt([&] {
+                if (withDataInfo) {
+                    graph.dumpAnimStack(bufferedFile);
+                } else {
+                    graph.dumpDag(bufferedFile);
+                }
+            });
+
+            fmt::print("{:>10} {:>10} {:>12.4f} {:>12.1f} {:>12.4f} {:>12.1f} {:>7.2f}x\n",
+                       nodeCount, withDataInfo ? "animstack" : "dag",
+                       ostreamTime, megaBytesPerSecond(ostreamFile, ostreamTime),
+                       bufferedTime, megaBytesPerSecond(bufferedFile, bufferedTime),
+                       bufferedTime > 0.0 ? ostreamTime / bufferedTime : 0.0);
+
+            const std::string style = withDataInfo ? "animstack" : "dag";
+            report.add({ "serializer", "ostream_" + style, { { "nodes", double(nodeCount) } },
+                         ostreamTime, nodeCount, std::filesystem::file_size(ostreamFile) });
+            report.add({ "serializer", "buffered_" + style, { { "nodes", double(nodeCount) } },
+                         bufferedTime, nodeCount, std::filesystem::file_size(bufferedFile) });
+        }
+    }
+
+    std::filesystem::remove(ostreamFile);
+    std::filesystem::remove(bufferedFile);
+}
+
+} // namespace fbxViz::bench
@@ -0,0 +1,82 @@
+# Copyright (C) 2022 Hamed Sabri
+#
+# All rights reserved.
+#
+# Redistribution and use in source and binary forms, with or without modification,
+# are permitted provided that the following conditions are met:
+#
+# 1. Redistributions of source code must retain the above copyright notice, this
+# list of conditions and the following disclaimer.
+# 2. Redistributions in binary form must reproduce the above copyright notice,
+# this list of conditions and the following disclaimer in the documentation
+# and/or other materials provided with the distribution.
+#
+# THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+# ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+# WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+# DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+# ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+# (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+# LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+# ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+# (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+# SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+
+# Basic module to find zstd.
+# This module searches for the zstd headers and library.
+#
+# Accepted variable as input:
+#
+#    ZSTD_LOCATION - (as a CMake or environment variable)
+#               The root directory of the zstd install.
+#
+# Variables that will be defined:
+#
+#    ZSTD_FOUND          Defined if a zstd installation has been detected
+#    ZSTD_INCLUDE_DIR    Path to the zstd include directory
+#    ZSTD_LIBRARIES      Path to the zstd library
+#
+# and the imported target Zstd::Zstd.
+#
+
+find_path(ZSTD_INCLUDE_DIR
+        zstd.h
+    HINTS
+        $ENV{ZSTD_LOCATION}
+        ${ZSTD_LOCATION}
+    PATH_SUFFIXES
+        include
+    DOC
+        "zstd header path"
+)
+mark_as_advanced(ZSTD_INCLUDE_DIR)
+
+find_library(ZSTD_LIBRARIES
+    NAMES
+        zstd
+        zstd_static
+    HINTS
+        $ENV{ZSTD_LOCATION}
+        ${ZSTD_LOCATION}
+    PATH_SUFFIXES
+        lib
+)
+mark_as_advanced(ZSTD_LIBRARIES)
+
+include(FindPackageHandleStandardArgs)
+
+find_package_handle_standard_args(Zstd
+    REQUIRED_VARS
+        ZSTD_INCLUDE_DIR
+        ZSTD_LIBRARIES
+)
+
+if(ZSTD_FOUND AND NOT TARGET Zstd::Zstd)
+    add_library(Zstd::Zstd UNKNOWN IMPORTED)
+    set_target_properties(Zstd::Zstd PROPERTIES
+        IMPORTED_LOCATION "${ZSTD_LIBRARIES}"
+        INTERFACE_INCLUDE_DIRECTORIES "${ZSTD_INCLUDE_DIR}"
+    )
+    message(STATUS "zstd include dir: ${ZSTD_INCLUDE_DIR}")
+    message(STATUS "zstd library: ${ZSTD_LIBRARIES}")
+endif()
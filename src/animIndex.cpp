@@ -0,0 +1,137 @@
+#include "animIndex.h"
+
+#include <algorithm>
+
+namespace {
+
+    // the node a property belongs to, possibly through the object owning it
+    FbxNode* owningNode(FbxObject* object)
+    {
+        if (!object) {
+            return nullptr;
+        }
+
+        if (auto node = FbxCast<FbxNode>(object)) {
+            return node;
+        }
+
+        // blend shape channel -> blend shape deformer -> geometry -> node
+        if (auto channel = FbxCast<FbxBlendShapeChannel>(object)) {
+            auto deformer = channel->GetBlendShapeDeformer();
+            auto geometry = deformer ? deformer->GetGeometry() : nullptr;
+            return geometry ? geometry->GetNode() : nullptr;
+        }
+
+        // node attributes, materials, ... are connected to their node
+        return object->GetDstObject<FbxNode>();
+    }
+
+    // local transforms keep the short names used so far ( TX, RY, SZ, ... )
+    const char* transformPrefix(FbxNode* node, FbxObject* owner, const FbxProperty& property)
+    {
+        if (owner != node) {
+            return nullptr;
+        }
+
+        if (property == node->LclTranslation) {
+            return "T";
+        } else if (property == node->LclRotation) {
+            return "R";
+        } else if (property == node->LclScaling) {
+            return "S";
+        }
+
+        return nullptr;
+    }
+
+    std::string channelName(FbxNode* node, FbxObject* owner, const FbxProperty& property, FbxAnimCurveNode* curveNode, unsigned int channel)
+    {
+        std::string name;
+
+        if (auto prefix = transformPrefix(node, owner, property)) {
+            name = prefix;
+            name += curveNode->GetChannelName(channel).Buffer();
+            return name;
+        }
+
+        // properties of other objects than the node or its attribute are
+        // prefixed with the object name ( e.g. a blend shape channel )
+        if (owner != node && owner != node->GetNodeAttribute()) {
+            name = owner->GetName();
+            name += "_";
+        }
+        name += property.GetName().Buffer();
+
+        if (curveNode->GetChannelsCount() > 1) {
+            name += "_";
+            name += curveNode->GetChannelName(channel).Buffer();
+        }
+
+        return name;
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+AnimLayerIndex::AnimLayerIndex(FbxAnimLayer* animLayer)
+{
+    for (auto i = 0; i < animLayer->GetMemberCount<FbxAnimCurveNode>(); ++i) {
+
+        FbxAnimCurveNode* curveNode = animLayer->GetMember<FbxAnimCurveNode>(i);
+
+        for (auto p = 0; p < curveNode->GetDstPropertyCount(); ++p) {
+
+            FbxProperty property = curveNode->GetDstProperty(p);
+            FbxObject* owner = property.GetFbxObject();
+            FbxNode* node = owningNode(owner);
+            if (!node) {
+                continue;
+            }
+
+            auto& channels = m_channels[node];
+            for (unsigned int c = 0; c < curveNode->GetChannelsCount(); ++c) {
+                const auto curveCount = curveNode->GetCurveCount(c);
+                for (auto k = 0; k < curveCount; ++k) {
+                    // a channel driven by several curves gets one name per
+                    // curve, e.g. "TX_0" and "TX_1", so their graph nodes,
+                    // sample columns and diff pairs stay apart
+                    auto name = channelName(node, owner, property, curveNode, c);
+                    if (curveCount > 1) {
+                        name += "_";
+                        name += std::to_string(k);
+                    }
+                    channels.push_back({ std::move(name), curveNode->GetCurve(c, k) });
+                }
+            }
+        }
+    }
+}
+
+const AnimLayerIndex::Channels* AnimLayerIndex::find(FbxNode* node) const
+{
+    auto it = m_channels.find(node);
+    return it != m_channels.end() && !it->second.empty() ? &it->second : nullptr;
+}
+
+bool AnimLayerIndex::empty() const
+{
+    return m_channels.empty();
+}
+
+std::vector<FbxAnimCurve*> AnimLayerIndex::curves() const
+{
+    std::vector<FbxAnimCurve*> result;
+    for (const auto& entry : m_channels) {
+        for (const auto& channel : entry.second) {
+            result.push_back(channel.curve);
+        }
+    }
+
+    // a curve can drive more than one property
+    std::sort(result.begin(), result.end());
+    result.erase(std::unique(result.begin(), result.end()), result.end());
+    return result;
+}
+
+} // namespace fbxViz
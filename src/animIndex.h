@@ -0,0 +1,65 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <fbxsdk.h>
+
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+namespace fbxViz {
+
+// one animated channel of a property, e.g. "TX", "Visibility" or
+// "smile_DeformPercent". When several curves drive one channel the index of
+// the curve is appended, "TX_0", "TX_1".
+struct AnimatedChannel
+{
+    std::string name;
+    FbxAnimCurve* curve{nullptr};
+};
+
+// every animated channel of an animation layer grouped by the FbxNode it
+// animates. Built by walking the FbxAnimCurveNodes of the layer once, so
+// properties owned by node attributes ( light intensity ), blend shape
+// channels or materials are found along with the local transforms.
+class AnimLayerIndex final
+{
+public:
+    using Channels = std::vector<AnimatedChannel>;
+
+    explicit AnimLayerIndex(FbxAnimLayer* animLayer);
+
+    // animated channels of a node in layer order, null if it has none
+    const Channels* find(FbxNode* node) const;
+    bool empty() const;
+
+    // every curve of the layer once, in no particular order
+    std::vector<FbxAnimCurve*> curves() const;
+
+private:
+    std::unordered_map<FbxNode*, Channels> m_channels;
+};
+
+} // namespace fbxViz
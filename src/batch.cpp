@@ -0,0 +1,338 @@
+#include "batch.h"
+#include "common.h"
+#include "parallel.h"
+#include "resultCache.h"
+#include "sceneValidation.h"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <filesystem>
+#include <fstream>
+#include <memory>
+#include <unordered_map>
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    bool hasWildcard(std::string_view name)
+    {
+        return name.find_first_of("*?") != std::string_view::npos;
+    }
+
+    // '*' matches any run of characters, '?' a single one
+    bool matchWildcard(std::string_view pattern, std::string_view name)
+    {
+        std::size_t p = 0, n = 0;
+        std::size_t starP = std::string_view::npos, starN = 0;
+
+        while (n < name.size()) {
+            if (p < pattern.size() && (pattern[p] == '?' || pattern[p] == name[n])) {
+                ++p;
+                ++n;
+            } else if (p < pattern.size() && pattern[p] == '*') {
+                starP = p++;
+                starN = n;
+            } else if (starP != std::string_view::npos) {
+                // let the last star swallow one more character
+                p = starP + 1;
+                n = ++starN;
+            } else {
+                return false;
+            }
+        }
+
+        while (p < pattern.size() && pattern[p] == '*') {
+            ++p;
+        }
+
+        return p == pattern.size();
+    }
+
+    // fbx files of a directory whose name matches the pattern, sorted
+    bool listDirectory(const fs::path& directory, std::string_view pattern, std::vector<std::string>& inputFiles)
+    {
+        std::error_code ec;
+        std::vector<std::string> found;
+        for (fs::directory_iterator it(directory, ec), end; !ec && it != end; it.increment(ec)) {
+            if (!it->is_regular_file(ec)) {
+                continue;
+            }
+
+            const auto name = it->path().filename().string();
+            if (fbxViz::hasFbxExtension(name) && matchWildcard(pattern, name)) {
+                found.push_back(it->path().string());
+            }
+        }
+
+        if (ec) {
+            fmt::print("Error: unable to read directory {}: {}!\n", directory.string(), ec.message());
+            return false;
+        }
+
+        std::sort(found.begin(), found.end());
+        inputFiles.insert(inputFiles.end(), found.begin(), found.end());
+        return true;
+    }
+
+    bool expandInput(const std::string& input, std::vector<std::string>& inputFiles)
+    {
+        const fs::path path(input);
+        const auto name = path.filename().string();
+
+        if (hasWildcard(name)) {
+            const auto directory = path.has_parent_path() ? path.parent_path() : fs::path(".");
+            return listDirectory(directory, name, inputFiles);
+        }
+
+        std::error_code ec;
+        if (fs::is_directory(path, ec)) {
+            return listDirectory(path, "*", inputFiles);
+        }
+
+        if (!fbxViz::hasFbxExtension(input)) {
+            fmt::print("Error: {} is not a valid fbx file!\n", input);
+            return false;
+        }
+
+        inputFiles.push_back(input);
+        return true;
+    }
+
+    // one input per line, empty lines and lines starting with '#' are skipped.
+    // Relative paths are relative to the manifest.
+    bool readManifest(const std::string& manifest, std::vector<std::string>& inputFiles)
+    {
+        std::ifstream file(manifest);
+        if (!file) {
+            fmt::print("Error: unable to open manifest {}!\n", manifest);
+            return false;
+        }
+
+        const auto base = fs::path(manifest).parent_path();
+
+        std::string line;
+        while (std::getline(file, line)) {
+            line.erase(line.find_last_not_of(" \t\r") + 1);
+            if (line.empty() || line[0] == '#') {
+                continue;
+            }
+
+            fs::path path(line);
+            if (path.is_relative()) {
+                path = base / path;
+            }
+
+            if (!expandInput(path.string(), inputFiles)) {
+                return false;
+            }
+        }
+
+        return true;
+    }
+
+    struct OutputFiles
+    {
+        std::string dag;
+        std::string animStack;
+    };
+
+    // <stem>.dag.dot and <stem>.animstack.dot, inputs sharing a stem get
+    // the index of their input appended
+    std::vector<OutputFiles> outputFiles(const std::vector<std::string>& inputFiles, const std::string& outputDir)
+    {
+        std::unordered_map<std::string, std::size_t> stemCounts;
+        for (const auto& input : inputFiles) {
+            ++stemCounts[fs::path(input).stem().string()];
+        }
+
+        std::vector<OutputFiles> outputs;
+        outputs.reserve(inputFiles.size());
+        for (std::size_t i = 0; i < inputFiles.size(); ++i) {
+            auto stem = fs::path(inputFiles[i]).stem().string();
+            if (stemCounts[stem] > 1) {
+                stem += fmt::format("_{}", i);
+            }
+
+            const fs::path dir(outputDir);
+            outputs.push_back({ (dir / (stem + ".dag.dot")).string(), (dir / (stem + ".animstack.dot")).string() });
+        }
+
+        return outputs;
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+bool hasFbxExtension(std::string_view inputFilePath)
+{
+    auto len = inputFilePath.length();
+    auto pos = inputFilePath.rfind('.', len);
+
+    if (pos != std::string::npos) {
+        auto ext = inputFilePath.substr(pos + 1 , len - 1);
+        if (ext == "fbx" || ext == "FBX") {
+            return true;
+        } else {
+            return false;
+        }
+    }
+
+    return false;
+}
+
+bool isBatch(const Options& options)
+{
+    if (!options.manifest.empty() || options.inputFiles.size() != 1) {
+        return true;
+    }
+
+    const auto& input = options.inputFiles.front();
+    std::error_code ec;
+    return hasWildcard(fs::path(input).filename().string()) || fs::is_directory(input, ec);
+}
+
+bool collectInputFiles(const Options& options, std::vector<std::string>& inputFiles)
+{
+    for (const auto& input : options.inputFiles) {
+        if (!expandInput(input, inputFiles)) {
+            return false;
+        }
+    }
+
+    if (!options.manifest.empty() && !readManifest(options.manifest, inputFiles)) {
+        return false;
+    }
+
+    return true;
+}
+
+std::size_t runBatch(const std::vector<std::string>& inputFiles, const Options& options, Profile* profile)
+{
+    if (!options.outputDir.empty()) {
+        std::error_code ec;
+        fs::create_directories(options.outputDir, ec);
+        if (ec) {
+            fmt::print("Error: unable to create output directory {}: {}!\n", options.outputDir, ec.message());
+            return inputFiles.size();
+        }
+    }
+
+    const auto outputs = outputFiles(inputFiles, options.outputDir);
+    const auto workers = static_cast<unsigned>(std::min<std::size_t>(workerCount(options.jobs), inputFiles.size()));
+
+    // the files keep the pool busy, every file is processed on one thread
+    auto fileOptions = options;
+    if (workers > 1) {
+        fileOptions.jobs = 1;
+    }
+
+    const auto start = std::chrono::steady_clock::now();
+
+    ResultCache cache(options);
+
+    std::atomic<std::size_t> next{0};
+    std::atomic<std::size_t> succeeded{0};
+    std::atomic<std::size_t> cacheHits{0};
+    parallelFor(workers, workers, [&](std::size_t) {
+        FbxManager* fbxManager{nullptr};
+        FbxScene* fbxScene{nullptr};
+        bool sceneUsed = false;
+
+        for (auto i = next++; i < inputFiles.size(); i = next++) {
+            const auto outputFiles = outputFileNames(outputs[i].dag, outputs[i].animStack, options);
+
+            std::string cacheKey;
+            if (cache.enabled()) {
+                cacheKey = cache.key(inputFiles[i]);
+                if (cache.fetch(cacheKey, outputFiles)) {
+                    ++succeeded;
+                    ++cacheHits;
+                    if (profile) {
+                        profile->count(Counter::Files);
+                        profile->count(Counter::CacheHits);
+                        profile->countFiles(outputFiles);
+                    }
+                    continue;
+                }
+            }
+
+            // the SDK is started by the first file missing the cache, the
+            // manager then lives as long as the worker. Every file gets a
+            // fresh scene.
+            if (!fbxManager) {
+                Profile::Scope scope(profile, Phase::Initialize);
+                if (!initialize(fbxManager, fbxScene)) {
+                    fmt::print("An error occurred initializing the fbx sdk...\n");
+                    destroy(fbxManager);
+                    return;
+                }
+            } else if (sceneUsed) {
+                fbxScene->Destroy();
+                fbxScene = FbxScene::Create(fbxManager, "Empty Scene");
+            }
+            sceneUsed = true;
+
+            if (!loadScene(fbxManager, fbxScene, inputFiles[i], options.validation, profile)) {
+                fmt::print("An error occurred while loading the scene {}...\n", inputFiles[i]);
+                continue;
+            }
+
+            std::unique_ptr<BackgroundValidation> validation;
+            if (options.validation == ValidationMode::Async) {
+                validation = std::make_unique<BackgroundValidation>(fbxScene, inputFiles[i], profile);
+            }
+
+            std::unique_ptr<FlatScene> flatScene;
+            {
+                Profile::Scope scope(profile, Phase::Flatten);
+                flatScene = std::make_unique<FlatScene>(fbxScene);
+            }
+
+            const auto root = findRootNode(*flatScene, fileOptions);
+            const bool dumped = dumpSceneToFile(*flatScene, root, outputFiles[0], fileOptions, profile)
+                                && dumpAnimStackToFile(*flatScene, root, outputFiles[1], fileOptions, profile);
+            flatScene.reset();
+
+            const bool validated = !validation || validation->wait();
+            if (!dumped) {
+                fmt::print("An error occurred while writing the graphs of {}...\n", inputFiles[i]);
+                continue;
+            }
+            if (!validated) {
+                fmt::print("An error occurred while validating the scene {}...\n", inputFiles[i]);
+                continue;
+            }
+            ++succeeded;
+
+            if (profile) {
+                profile->count(Counter::Files);
+                profile->countFiles(outputFiles);
+            }
+
+            if (cache.enabled()) {
+                cache.store(cacheKey, outputFiles);
+            }
+        }
+
+        destroy(fbxManager);
+    });
+
+    const auto seconds = std::chrono::duration<double>(std::chrono::steady_clock::now() - start).count();
+    const auto failed = inputFiles.size() - succeeded;
+
+    fmt::print("Processed {} files ( {} failed, {} from cache ) on {} workers in {:.2f} s, {:.2f} files/s\n",
+               inputFiles.size(), failed, cacheHits.load(), workers, seconds, seconds > 0.0 ? inputFiles.size() / seconds : 0.0);
+
+    if (cache.enabled()) {
+        cache.evict();
+    }
+
+    return failed;
+}
+
+} // namespace fbxViz
@@ -1,162 +1,552 @@
 #include "common.h"
+#include "animIndex.h"
 #include "curveInfo.h"
+#include "curveSampler.h"
+#include "hash.h"
+#include "layerCurves.h"
+#include "meshStats.h"
+#include "nodeFilter.h"
+#include "nodeType.h"
+#include "parallel.h"
+#include "sceneDiff.h"
+#include "sceneValidation.h"
+#include "transformEvaluator.h"
 
 #include "graph/graph.h"
+#include "graph/graphSnapshot.h"
+#include "graph/graphWriter.h"
 #include "graph/node.h"
+#include "graph/nodeData.h"
 
-#include <fmt/core.h>
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <vector>
 
 namespace {
 
-    fbxViz::Node createNode(fbxViz::DGraph& graph, std::string_view name, std::string_view type)
+    fbxViz::NodeRef createNode(fbxViz::GraphSink& graph, const fbxViz::NodeKey& key, std::string_view name, std::string_view type, std::string_view dataInfo = {},
+                               std::string_view fillColor = {})
     {
         fbxViz::Node node(name);
         node.setType(type);
-        graph.addNode(node);
-        return node;
+        node.setDataInfo(dataInfo);
+        node.setFillColor(fillColor);
+        return { graph.addNode(key, node), name };
     }
 
-    fbxViz::Edge createEdge(fbxViz::DGraph& graph, fbxViz::Node& nodeA, fbxViz::Node& nodeB, std::string_view name=" ")
+    // interns the graph node of a scene node, its name and attribute label
+    // come from the flattened scene.
+    fbxViz::NodeRef createNode(fbxViz::GraphSink& graph, const fbxViz::FlatScene& scene, fbxViz::FlatScene::Index index, std::string_view dataInfo = {},
+                               std::string_view fillColor = {})
     {
-        fbxViz::Edge edge(nodeA, nodeB);
-        edge.setName(name);
-        graph.addEdge(edge);
-        return edge;
+        fbxViz::NodeKey key(scene.uniqueId(index));
+
+        auto nodeId = graph.findNode(key);
+        if (nodeId == fbxViz::InvalidNodeId) {
+            return createNode(graph, key, scene.name(index), scene.typeName(index), dataInfo, fillColor);
+        }
+
+        return { nodeId, scene.name(index) };
     }
 
-    FbxString attributeTypeName(FbxNodeAttribute::EType type) 
+    // what the animation stack traversal produces besides the graph
+    // the keys of a curve kept for --snapshot and --sample
+    struct KeptCurve
     {
-        switch(type) {
-            case FbxNodeAttribute::eUnknown: return "unidentified";
-            case FbxNodeAttribute::eNull: return "null";
-            case FbxNodeAttribute::eMarker: return "marker";
-            case FbxNodeAttribute::eSkeleton: return "skeleton";
-            case FbxNodeAttribute::eMesh: return "mesh";
-            case FbxNodeAttribute::eNurbs: return "nurbs";
-            case FbxNodeAttribute::ePatch: return "patch";
-            case FbxNodeAttribute::eCamera: return "camera";
-            case FbxNodeAttribute::eCameraStereo: return "stereo";
-            case FbxNodeAttribute::eCameraSwitcher: return "camera switcher";
-            case FbxNodeAttribute::eLight: return "light";
-            case FbxNodeAttribute::eOpticalReference: return "optical reference";
-            case FbxNodeAttribute::eOpticalMarker: return "marker";
-            case FbxNodeAttribute::eNurbsCurve: return "nurbs curve";
-            case FbxNodeAttribute::eTrimNurbsSurface: return "trim nurbs surface";
-            case FbxNodeAttribute::eBoundary: return "boundary";
-            case FbxNodeAttribute::eNurbsSurface: return "nurbs surface";
-            case FbxNodeAttribute::eShape: return "shape";
-            case FbxNodeAttribute::eLODGroup: return "lodgroup";
-            case FbxNodeAttribute::eSubDiv: return "subdiv";
-            default: return "unknown";
-        }
+        fbxViz::NodeKey key;    // of the curve node
+        FbxAnimStack* animStack;
+        std::string channel;    // "stack/layer/node_property"
+        fbxViz::CurveSnapshot snapshot;
+    };
+
+    struct AnimStackOutput
+    {
+        // --redundant-keys text report
+        std::string report;
+
+        std::vector<KeptCurve> curves;
+
+        // --profile counters
+        std::uint64_t curveCount{0};
+        std::uint64_t keyCount{0};
+    };
+
+    // state shared by the traversal of one animation layer
+    struct LayerTraversal
+    {
+        const fbxViz::FlatScene& scene;
+        fbxViz::FlatScene::Index root;
+        const fbxViz::AnimLayerIndex& layerIndex;
+        const fbxViz::CurveDetail& curveDetail;
+        const fbxViz::NodeFilter& filter;
+
+        // only with --redundant-keys
+        const fbxViz::LayerCurves* layerCurves;
+
+        bool keepCurves;
+        AnimStackOutput& output;
+
+        // the stack of the layer, --sample writes one table per stack
+        FbxAnimStack* animStack;
+
+        // "stack/layer/", the channel names of the kept curves start with it
+        std::string_view layerPath;
+
+        // scratch for the names of the curve nodes, reused across the layer
+        std::string& nameBuffer;
+    };
+
+    void curveKeyInfo(fbxViz::GraphSink& dGraph, fbxViz::FlatScene::Index index, std::string_view propName, FbxAnimCurve* curveNode, const fbxViz::NodeRef& animNode, const LayerTraversal& traversal)
+    {
+       const auto& scene = traversal.scene;
+
+       // "node_channel" and "node_channel_animCurve" share the buffer of the layer
+       auto& names = traversal.nameBuffer;
+       names.assign(scene.name(index)).append("_").append(propName);
+       const auto propertyNameSize = names.size();
+       names.append("_animCurve");
+
+       const std::string_view nodeName(names.data(), propertyNameSize);
+       const std::string_view animCurveNodeName(names);
+
+       const auto propertyType = fbxViz::nodeTypeName(fbxViz::NodeType::Property);
+       auto propertyNode = createNode(dGraph, fbxViz::NodeKey(scene.uniqueId(index), propName), nodeName, propertyType);
+       dGraph.addEdge(animNode, propertyNode);
+
+       fbxViz::CurveSnapshot extracted;
+       const fbxViz::CurveSnapshot* snapshot = &extracted;
+
+       std::string dataInfo;
+       if (traversal.layerCurves) {
+           const auto& redundancy = traversal.layerCurves->redundancy(curveNode);
+           dataInfo = fbxViz::getKeyRedundancyInfo(redundancy);
+           snapshot = &traversal.layerCurves->snapshot(curveNode);
+
+           fmt::format_to(std::back_inserter(traversal.output.report), "      {}: {} / {} keys ( {:.1f}% )\n",
+                          propName, redundancy.removable(), redundancy.keyCount, redundancy.percent());
+       } else {
+           extracted = fbxViz::extractCurve(curveNode);
+       }
+       dataInfo += fbxViz::getCurveAnimKeyInfo(*snapshot, traversal.curveDetail);
+
+       fbxViz::NodeKey curveKey(curveNode->GetUniqueID());
+       auto animCurveNode = createNode(dGraph, curveKey, animCurveNodeName, propertyType, dataInfo);
+
+       ++traversal.output.curveCount;
+       traversal.output.keyCount += snapshot->keyCount();
+
+       if (traversal.keepCurves) {
+           traversal.output.curves.push_back({ curveKey, traversal.animStack, fmt::format("{}{}", traversal.layerPath, nodeName), *snapshot });
+       }
+
+       dGraph.addEdge(propertyNode, animCurveNode);
     }
 
-    std::string getAttrName(FbxNode* pNode) 
+    void getAnimCurveInfo(fbxViz::GraphSink& dGraph, fbxViz::FlatScene::Index index, const fbxViz::AnimLayerIndex::Channels& channels, const fbxViz::NodeRef& animNode, const LayerTraversal& traversal)
     {
-        FbxString typeName;
-        for(int i = 0; i < pNode->GetNodeAttributeCount(); i++) {
-            FbxNodeAttribute* pAttribute = pNode->GetNodeAttributeByIndex(i);
-            typeName += attributeTypeName(pAttribute->GetAttributeType());
+        if (traversal.layerCurves) {
+            fbxViz::KeyRedundancy nodeRedundancy;
+            for (const auto& channel : channels) {
+                nodeRedundancy += traversal.layerCurves->redundancy(channel.curve);
+            }
+
+            fmt::format_to(std::back_inserter(traversal.output.report), "    {}: {} / {} keys ( {:.1f}% )\n",
+                           traversal.scene.name(index), nodeRedundancy.removable(), nodeRedundancy.keyCount, nodeRedundancy.percent());
         }
 
-        return std::string( typeName.Buffer() );
+        for (const auto& channel : channels) {
+            curveKeyInfo(dGraph, index, channel.name, channel.curve, animNode, traversal);
+        }
     }
 
-    // recursively traverse a node
-    void traverseNode(fbxViz::DGraph& dGraph, FbxNode* fbxNode)
+    // walks the subtree of the traversal root for the nodes with animated
+    // channels in this layer, they are the ones we are interested in
+    void traverseAnimationLayer(fbxViz::GraphSink& dGraph, const fbxViz::NodeRef& animLayerNode, const LayerTraversal& traversal)
     {
-        for(auto i= 0; i < fbxNode->GetChildCount(); i++) {
-           auto childNode = createNode(dGraph, fbxNode->GetName(), getAttrName(fbxNode));
-           auto nextChildNode = createNode(dGraph, fbxNode->GetChild(i)->GetName(), getAttrName(fbxNode->GetChild(i)));
-           createEdge(dGraph, childNode, nextChildNode);
+        const auto& scene = traversal.scene;
+        scene.walk(traversal.root, [&](fbxViz::FlatScene::Index index, unsigned depth) {
+            auto channels = traversal.layerIndex.find(scene.node(index));
+            if (channels && traversal.filter.matches(scene, index)) {
+
+                auto animNode = createNode(dGraph, scene, index);
+                dGraph.addEdge(animLayerNode, animNode);
 
-           traverseNode( dGraph, fbxNode->GetChild(i));
+                getAnimCurveInfo(dGraph, index, *channels, animNode, traversal);
+            }
+
+            return traversal.filter.descend(depth);
+        });
+    }
+
+    // the local time span of the animation stack. Without a stack or a span
+    // the curves are sampled from their first to their last key.
+    fbxViz::SampleGrid sampleGrid(FbxAnimStack* animStack, const std::vector<const fbxViz::CurveSnapshot*>& curves, float frameRate)
+    {
+        fbxViz::SampleGrid grid;
+        grid.frameRate = frameRate;
+        grid.start = std::numeric_limits<std::int64_t>::max();
+        grid.stop = std::numeric_limits<std::int64_t>::min();
+
+        if (animStack) {
+            const auto span = animStack->GetLocalTimeSpan();
+            const auto start = span.GetStart().Get();
+            const auto stop = span.GetStop().Get();
+            if (stop > start) {
+                grid.start = start;
+                grid.stop = stop;
+            }
         }
+
+        if (grid.start > grid.stop) {
+            for (const auto* curve : curves) {
+                if (curve->keyCount() > 0) {
+                    grid.start = std::min(grid.start, curve->times.front());
+                    grid.stop = std::max(grid.stop, curve->times.back());
+                }
+            }
+        }
+
+        if (grid.start > grid.stop) {
+            grid.start = 0;
+            grid.stop = 0;
+        }
+
+        return grid;
+    }
+
+    // the CPU time of a phase is measured on the calling thread, see
+    // Profile::Scope. With several workers the parallel passes, and with
+    // --compress every write, also run on other threads.
+    bool computesOnCallingThread(const fbxViz::Options& options)
+    {
+        return fbxViz::workerCount(options.jobs) <= 1;
+    }
+
+    bool writesOnCallingThread(const fbxViz::Options& options)
+    {
+        return options.compression == fbxViz::Compression::None;
     }
 
-    void curveKeyInfo(fbxViz::DGraph& dGraph, FbxNode* pNode, std::string_view propName, FbxAnimCurve* curveNode, fbxViz::Node& animNode) 
+    // what --motion-bounds and --mesh-stats add to the nodes of the scene
+    // DAG, by FlatScene index, empty when not asked for
+    struct SceneAnnotations
     {
-       std::string nodeName(pNode->GetName());
-       nodeName.append("_");
-       nodeName.append(propName.data());
+        std::vector<fbxViz::MotionBounds> motionBounds;
+        fbxViz::SceneMeshStats meshStats;
+    };
 
-       auto propertyNode = createNode(dGraph, nodeName, "property");
-       createEdge(dGraph, animNode, propertyNode);
+    // data rows of a scene node with the box it moves in
+    void appendMotionBoundsInfo(std::string& dataInfo, const fbxViz::MotionBounds& bounds)
+    {
+        fbxViz::NodeDataBuilder(dataInfo)
+            .row().field("Min X", bounds.min[0], 3).field("Min Y", bounds.min[1], 3).field("Min Z", bounds.min[2], 3)
+            .row().field("Max X", bounds.max[0], 3).field("Max Y", bounds.max[1], 3).field("Max Z", bounds.max[2], 3)
+            .row().field("Motion extent", bounds.extent(), 3);
+    }
 
-       std::string animCurveNodeName(pNode->GetName());
-       animCurveNodeName.append("_");
-       animCurveNodeName.append(propName.data());
-       animCurveNodeName.append("_animCurve");
+    // data rows of a scene node with the cost of its own meshes and, when
+    // its descendants have meshes too, of its whole subtree
+    void appendMeshStatsInfo(std::string& dataInfo, const fbxViz::MeshStats& own, const fbxViz::MeshStats& subtree)
+    {
+        constexpr double MegaByte = 1024.0 * 1024.0;
 
-       auto animCurveNode = createNode(dGraph, animCurveNodeName, "property");
-       animCurveNode.setDataInfo(fbxViz::getCurveAnimKeyInfo(curveNode));
-       dGraph.addNode(animCurveNode);
+        fbxViz::NodeDataBuilder data(dataInfo);
+        if (own.meshes > 0) {
+            data.row().field("Control points", own.controlPoints).field("Polygons", own.polygons).field("Triangles", own.triangles);
+            data.row().field("UV sets", own.uvSets).field("Layer elements", own.layerElements).field("GPU MB", own.gpuBytes / MegaByte, 2);
+        }
+        if (subtree.meshes > own.meshes) {
+            data.row().field("Subtree meshes", subtree.meshes).field("Subtree triangles", subtree.triangles)
+                .field("Subtree GPU MB", subtree.gpuBytes / MegaByte, 2);
+        }
+    }
 
-       createEdge(dGraph, propertyNode, animCurveNode);
+    // light yellow to dark red by the share of the scene's GPU memory
+    // estimate below a node, on a log scale over four decades so the
+    // heaviest assets and the paths down to them stand out
+    std::string meshCostColor(std::uint64_t bytes, std::uint64_t totalBytes)
+    {
+        constexpr int Stops[3][3] = { { 255, 255, 178 }, { 253, 141, 60 }, { 189, 0, 38 } };
+
+        const double share = totalBytes > 0 ? static_cast<double>(bytes) / static_cast<double>(totalBytes) : 0.0;
+        const double t = share > 0.0 ? std::clamp(1.0 + std::log10(share) / 4.0, 0.0, 1.0) : 0.0;
+
+        const int stop = t < 0.5 ? 0 : 1;
+        const double s = t < 0.5 ? t * 2.0 : (t - 0.5) * 2.0;
+
+        int rgb[3];
+        for (int c = 0; c < 3; ++c) {
+            rgb[c] = static_cast<int>(std::lround(Stops[stop][c] + (Stops[stop + 1][c] - Stops[stop][c]) * s));
+        }
+        return fmt::format("#{:02x}{:02x}{:02x}", rgb[0], rgb[1], rgb[2]);
     }
 
-    void getAnimCurveInfo(fbxViz::DGraph& dGraph, FbxNode* pNode, FbxAnimLayer* pAnimLayer, fbxViz::Node& animNode) 
+    void annotateNode(const SceneAnnotations& annotations, fbxViz::FlatScene::Index index, std::string& dataInfo, std::string& fillColor)
     {
-        FbxAnimCurve* curveNode{nullptr};
-        curveNode = pNode->LclTranslation.GetCurve(pAnimLayer, FBXSDK_CURVENODE_COMPONENT_X);
-        // T
-        if (curveNode) {
-           curveKeyInfo(dGraph, pNode, "TX", curveNode, animNode);
+        dataInfo.clear();
+        fillColor.clear();
+
+        if (!annotations.motionBounds.empty()) {
+            appendMotionBoundsInfo(dataInfo, annotations.motionBounds[index]);
         }
-        curveNode = pNode->LclTranslation.GetCurve(pAnimLayer, FBXSDK_CURVENODE_COMPONENT_Y);
-        if (curveNode) {
-           curveKeyInfo(dGraph, pNode, "TY", curveNode, animNode);
+
+        const auto& meshStats = annotations.meshStats;
+        if (!meshStats.subtree.empty() && meshStats.subtree[index].meshes > 0) {
+            appendMeshStatsInfo(dataInfo, meshStats.own[index], meshStats.subtree[index]);
+            fillColor = meshCostColor(meshStats.subtree[index].gpuBytes, meshStats.subtree[0].gpuBytes);
         }
-        curveNode = pNode->LclTranslation.GetCurve(pAnimLayer, FBXSDK_CURVENODE_COMPONENT_Z);
-        if (curveNode) {
-           curveKeyInfo(dGraph, pNode, "TZ", curveNode, animNode);
+    }
+
+    // the world space box of every node over the time span of the first
+    // animation stack, from the curves of its base layer
+    std::vector<fbxViz::MotionBounds> computeMotionBounds(const fbxViz::FlatScene& scene, const fbxViz::Options& options)
+    {
+        FbxScene* pScene = scene.scene();
+        FbxAnimStack* animStack = pScene->GetSrcObjectCount<FbxAnimStack>() > 0 ? pScene->GetSrcObject<FbxAnimStack>(0) : nullptr;
+        FbxAnimLayer* animLayer = animStack && animStack->GetMemberCount<FbxAnimLayer>() > 0 ? animStack->GetMember<FbxAnimLayer>(0) : nullptr;
+
+        fbxViz::TransformEvaluator evaluator(scene, animLayer);
+
+        std::vector<const fbxViz::CurveSnapshot*> curves;
+        for (const auto& curve : evaluator.curves()) {
+            curves.push_back(&curve);
         }
-        // R
-        curveNode = pNode->LclRotation.GetCurve(pAnimLayer, FBXSDK_CURVENODE_COMPONENT_X);
-        if (curveNode){
-            curveKeyInfo(dGraph, pNode, "RX", curveNode, animNode);
+
+        const auto grid = sampleGrid(animStack, curves, options.motionBoundsRate);
+        auto bounds = evaluator.motionBounds(grid, options.jobs);
+
+        fmt::print("Evaluated the world transforms of {} nodes at {} frames, {} of them inherit RrSs and were evaluated as RSrs.\n",
+                   scene.size(), grid.frameCount(), evaluator.approximatedCount());
+        return bounds;
+    }
+
+    // walks the subtree of root. Nodes the filter rejects are walked through,
+    // their matching descendants hang off the closest emitted ancestor. The
+    // root is emitted whatever the type and name filters say. The emitted
+    // nodes get the rows and colors of the annotations.
+    void buildSceneGraph(fbxViz::GraphSink& dGraph, const fbxViz::FlatScene& scene, fbxViz::FlatScene::Index root, const fbxViz::NodeFilter& filter,
+                         const SceneAnnotations& annotations)
+    {
+        // the graph node the children of each scene node hang off
+        std::vector<fbxViz::NodeRef> parents(scene.size());
+
+        std::string dataInfo;
+        std::string fillColor;
+        scene.walk(root, [&](fbxViz::FlatScene::Index index, unsigned depth) {
+            if (index == root || filter.matches(scene, index)) {
+                annotateNode(annotations, index, dataInfo, fillColor);
+                parents[index] = createNode(dGraph, scene, index, dataInfo, fillColor);
+                if (index != root) {
+                    dGraph.addEdge(parents[scene.parent(index)], parents[index]);
+                }
+            } else {
+                parents[index] = parents[scene.parent(index)];
+            }
+
+            return filter.descend(depth);
+        });
+    }
+
+    fbxViz::NodeRef createAnimStackNode(fbxViz::GraphSink& dGraph, FbxAnimStack* animStack)
+    {
+        return createNode(dGraph, fbxViz::NodeKey(animStack->GetUniqueID()), animStack->GetName(), fbxViz::nodeTypeName(fbxViz::NodeType::AnimationStack));
+    }
+
+    // the nodes below root that pass the filter are walked, `jobs` is used
+    // for the per curve analysis of the layer, reports and curves are appended
+    // to `output`
+    void buildAnimLayerGraph(fbxViz::GraphSink& dGraph, const fbxViz::FlatScene& scene, fbxViz::FlatScene::Index root, const fbxViz::NodeFilter& filter, FbxAnimStack* animStack,
+                             const fbxViz::NodeRef& animStackNode, FbxAnimLayer* animLayer, const fbxViz::Options& options, unsigned jobs, AnimStackOutput& output)
+    {
+        // one pass over the curve nodes of the layer instead of
+        // querying the curves of every node
+        fbxViz::AnimLayerIndex layerIndex(animLayer);
+
+        std::unique_ptr<fbxViz::LayerCurves> layerCurves;
+        std::string dataInfo;
+        if (options.redundantKeys && !layerIndex.empty()) {
+            layerCurves = std::make_unique<fbxViz::LayerCurves>(layerIndex, options.redundantKeyTolerance, jobs);
+
+            const auto& total = layerCurves->total();
+            dataInfo = fbxViz::getKeyRedundancyInfo(total);
+
+            fmt::format_to(std::back_inserter(output.report), "  {} / {}: {} / {} keys ( {:.1f}% )\n",
+                           animStackNode.name, animLayer->GetName(), total.removable(), total.keyCount, total.percent());
         }
-        curveNode = pNode->LclRotation.GetCurve(pAnimLayer, FBXSDK_CURVENODE_COMPONENT_Y);
-        if (curveNode){
-            curveKeyInfo(dGraph, pNode, "RY", curveNode, animNode);
+
+        auto animLayerNode = createNode(dGraph, fbxViz::NodeKey(animLayer->GetUniqueID()), animLayer->GetName(), fbxViz::nodeTypeName(fbxViz::NodeType::AnimationLayer), dataInfo);
+        dGraph.addEdge(animStackNode, animLayerNode);
+
+        if (!layerIndex.empty()) {
+            const bool keepCurves = (options.snapshot && !options.streaming) || options.sample;
+            const auto layerPath = fmt::format("{}/{}/", animStackNode.name, animLayer->GetName());
+            std::string nameBuffer;
+            LayerTraversal traversal{ scene, root, layerIndex, options.curveDetail, filter, layerCurves.get(), keepCurves, output, animStack, layerPath, nameBuffer };
+            traverseAnimationLayer(dGraph, animLayerNode, traversal);
         }
-        curveNode = pNode->LclRotation.GetCurve(pAnimLayer, FBXSDK_CURVENODE_COMPONENT_Z);
-        if (curveNode){
-            curveKeyInfo(dGraph, pNode, "RZ", curveNode, animNode);
+    }
+
+    void buildAnimStackGraph(fbxViz::GraphSink& dGraph, const fbxViz::FlatScene& scene, fbxViz::FlatScene::Index root, const fbxViz::NodeFilter& filter,
+                             const fbxViz::Options& options, AnimStackOutput& output)
+    {
+        FbxScene* pScene = scene.scene();
+        for (auto i = 0; i < pScene->GetSrcObjectCount<FbxAnimStack>(); i++) {
+
+            FbxAnimStack* animStack = pScene->GetSrcObject<FbxAnimStack>(i);
+        
+            // animation stack node ( graph )
+            auto animStackNode = createAnimStackNode(dGraph, animStack);
+
+            // traverse animation stack
+            for (auto i = 0; i < animStack->GetMemberCount<FbxAnimLayer>(); ++i) {
+                buildAnimLayerGraph(dGraph, scene, root, filter, animStack, animStackNode, animStack->GetMember<FbxAnimLayer>(i), options, options.jobs, output);
+            }
         }
-        // S
-        curveNode = pNode->LclScaling.GetCurve(pAnimLayer, FBXSDK_CURVENODE_COMPONENT_X);
-        if (curveNode){
-            curveKeyInfo(dGraph, pNode, "SX", curveNode, animNode);
+    }
+
+    // every ( stack, layer ) pair is extracted into a private subgraph on the
+    // worker pool. The traversal only reads the scene. Subgraphs are merged
+    // back in scene order, so the result is identical to buildAnimStackGraph.
+    void buildAnimStackGraphParallel(fbxViz::DGraph& dGraph, const fbxViz::FlatScene& scene, fbxViz::FlatScene::Index root, const fbxViz::NodeFilter& filter,
+                                     const fbxViz::Options& options, AnimStackOutput& output)
+    {
+        FbxScene* pScene = scene.scene();
+
+        struct LayerTask
+        {
+            FbxAnimStack* animStack;
+            FbxAnimLayer* animLayer; // null for a stack without layers
+        };
+
+        std::vector<LayerTask> tasks;
+        for (auto i = 0; i < pScene->GetSrcObjectCount<FbxAnimStack>(); i++) {
+
+            FbxAnimStack* animStack = pScene->GetSrcObject<FbxAnimStack>(i);
+
+            const auto layerCount = animStack->GetMemberCount<FbxAnimLayer>();
+            if (layerCount == 0) {
+                tasks.push_back({ animStack, nullptr });
+            }
+            for (auto i = 0; i < layerCount; ++i) {
+                tasks.push_back({ animStack, animStack->GetMember<FbxAnimLayer>(i) });
+            }
         }
-        curveNode = pNode->LclScaling.GetCurve(pAnimLayer, FBXSDK_CURVENODE_COMPONENT_Y);
-        if (curveNode){
-            curveKeyInfo(dGraph, pNode, "SY", curveNode, animNode);
+
+        std::vector<std::unique_ptr<fbxViz::DGraph>> subGraphs(tasks.size());
+        std::vector<AnimStackOutput> outputs(tasks.size());
+        fbxViz::parallelFor(tasks.size(), options.jobs, [&](std::size_t i) {
+            auto subGraph = std::make_unique<fbxViz::DGraph>(dGraph.graphName);
+
+            // the layers already keep the pool busy, their curves are
+            // analysed on the worker that owns the layer
+            auto animStackNode = createAnimStackNode(*subGraph, tasks[i].animStack);
+            if (tasks[i].animLayer) {
+                buildAnimLayerGraph(*subGraph, scene, root, filter, tasks[i].animStack, animStackNode, tasks[i].animLayer, options, 1, outputs[i]);
+            }
+
+            subGraphs[i] = std::move(subGraph);
+        });
+
+        for (std::size_t i = 0; i < subGraphs.size(); ++i) {
+            dGraph.merge(*subGraphs[i]);
+            subGraphs[i].reset();
+            output.report += outputs[i].report;
+            output.curveCount += outputs[i].curveCount;
+            output.keyCount += outputs[i].keyCount;
+            std::move(outputs[i].curves.begin(), outputs[i].curves.end(), std::back_inserter(output.curves));
         }
-        curveNode = pNode->LclScaling.GetCurve(pAnimLayer, FBXSDK_CURVENODE_COMPONENT_Z);
-        if (curveNode){
-            curveKeyInfo(dGraph, pNode, "SZ", curveNode, animNode);
+    }
+
+    // "animstack.dot" -> "animstack.samples.csv", compressed like the graphs
+    std::string sampleFileName(std::string_view animStackFile, const fbxViz::Options& options)
+    {
+        const std::string_view extension = options.sampleFormat == fbxViz::SampleFormat::Csv ? ".samples.csv" : ".samples.bin";
+        return fbxViz::replaceGraphExtension(animStackFile, fmt::format("{}{}", extension, fbxViz::compressionExtension(options.compression)));
+    }
+
+    std::uint64_t hashCurve(const fbxViz::CurveSnapshot& snapshot)
+    {
+        fbxViz::ContentHash hash;
+        hash.update(snapshot.times.data(), snapshot.times.size() * sizeof(std::int64_t));
+        hash.update(snapshot.values.data(), snapshot.values.size() * sizeof(float));
+        hash.update(snapshot.leftDerivatives.data(), snapshot.leftDerivatives.size() * sizeof(float));
+        hash.update(snapshot.rightDerivatives.data(), snapshot.rightDerivatives.size() * sizeof(float));
+        hash.update(snapshot.flags.data(), snapshot.flags.size());
+        return hash.digest();
+    }
+
+    std::uint64_t hashTransform(FbxNode* pNode)
+    {
+        fbxViz::ContentHash hash;
+        for (const FbxDouble3& value : { pNode->LclTranslation.Get(), pNode->LclRotation.Get(), pNode->LclScaling.Get() }) {
+            hash.update(value.mData, sizeof(value.mData));
         }
+        return hash.digest();
     }
 
-    // traverse animation layer recursively
-    void traverseAnimationLayer(fbxViz::DGraph& dGraph, FbxAnimStack* pAnimStack, FbxAnimLayer* pAnimLayer, FbxNode* pNode, fbxViz::Node& animLayerNode)
+    // hashes the whole hierarchy of the flattened scene, the entries share
+    // its pre-order indices. Curves are named "stack_layer_channel".
+    fbxViz::SceneHashTree buildSceneHashTree(const fbxViz::FlatScene& scene)
     {
-        // if the curve count is greater than zero, the node has animation info 
-        // that we are interested in
-        FbxArray<FbxAnimCurve*> curves;
-        GetAllAnimCurves( pNode, pAnimStack, curves );
-        if (curves.GetCount() > 0 ) {
+        FbxScene* pScene = scene.scene();
 
-            auto animNode = createNode(dGraph, pNode->GetName(), getAttrName(pNode));
-            createEdge(dGraph, animLayerNode, animNode);
+        struct LayerChannels
+        {
+            std::string prefix;
+            fbxViz::AnimLayerIndex index;
+        };
 
-            getAnimCurveInfo(dGraph, pNode, pAnimLayer, animNode);
+        std::vector<LayerChannels> layers;
+        for (auto i = 0; i < pScene->GetSrcObjectCount<FbxAnimStack>(); i++) {
+            FbxAnimStack* animStack = pScene->GetSrcObject<FbxAnimStack>(i);
+            for (auto l = 0; l < animStack->GetMemberCount<FbxAnimLayer>(); ++l) {
+                FbxAnimLayer* animLayer = animStack->GetMember<FbxAnimLayer>(l);
+                layers.push_back({ fmt::format("{}_{}_", animStack->GetName(), animLayer->GetName()), fbxViz::AnimLayerIndex(animLayer) });
+            }
         }
 
-        for(auto i = 0; i < pNode->GetChildCount(); ++i) {
-            traverseAnimationLayer(dGraph, pAnimStack, pAnimLayer, pNode->GetChild(i), animLayerNode);
+        fbxViz::SceneHashTree tree;
+        tree.entries.resize(scene.size());
+        for (fbxViz::FlatScene::Index index = 0; index < scene.size(); ++index) {
+            FbxNode* pNode = scene.node(index);
+
+            auto& entry = tree.entries[index];
+            entry.name = scene.name(index);
+            entry.type = scene.typeName(index);
+
+            fbxViz::ContentHash attributeHash;
+            attributeHash.update(entry.name);
+            attributeHash.update(entry.type);
+            entry.attributeHash = attributeHash.digest();
+            entry.transformHash = hashTransform(pNode);
+
+            for (const auto& layer : layers) {
+                if (auto channels = layer.index.find(pNode)) {
+                    for (const auto& channel : *channels) {
+                        const auto snapshot = fbxViz::extractCurve(channel.curve);
+                        entry.curves.push_back({ layer.prefix + channel.name, hashCurve(snapshot), snapshot.keyCount() });
+                    }
+                }
+            }
+
+            std::sort(entry.curves.begin(), entry.curves.end(),
+                      [](const auto& a, const auto& b) { return a.channel < b.channel; });
+            for (const auto& curve : entry.curves) {
+                entry.curvesHash = fbxViz::hashCombine(entry.curvesHash, fbxViz::hashCombine(std::hash<std::string>()(curve.channel), curve.hash));
+            }
+
+            for (auto child = scene.firstChild(index); child != fbxViz::FlatScene::None; child = scene.nextSibling(child)) {
+                entry.children.push_back(child);
+            }
         }
+
+        tree.finalize();
+        return tree;
     }
 
 } // namespace
@@ -195,7 +585,7 @@ void destroy(FbxManager* pManager)
     }
 }
 
-bool loadScene(FbxManager* pManager, FbxDocument* pScene, std::string_view pFilename)
+bool loadScene(FbxManager* pManager, FbxDocument* pScene, std::string_view pFilename, ValidationMode validation, Profile* profile)
 {
     auto fileMajor{-1}, fileMinor{-1}, fileRevision{-1};
     bool status = false;
@@ -215,14 +605,14 @@ bool loadScene(FbxManager* pManager, FbxDocument* pScene, std::string_view pFile
     }
 
     // import the contents of the file into the scene.
-    status = importer->Import(pScene);
+    {
+        Profile::Scope scope(profile, Phase::Import);
+        status = importer->Import(pScene);
+    }
     
-    if (status) {
-        // check the scene integrity
-        FbxStatus stat;
-        FbxArray< FbxString*> details;
-        FbxSceneCheckUtility sceneCheck(FbxCast<FbxScene>(pScene), &stat, &details);
-        status = sceneCheck.Validate(FbxSceneCheckUtility::eCkeckData);
+    // the async checks are started by the caller once the scene is loaded
+    if (status && validation != ValidationMode::Async) {
+        status = validateScene(FbxCast<FbxScene>(pScene), pFilename, validation, profile);
     }
 
     // destroy the importer
@@ -231,58 +621,222 @@ bool loadScene(FbxManager* pManager, FbxDocument* pScene, std::string_view pFile
     return status;
 }
 
-void dumpSceneToFile(FbxScene* pScene, std::string_view fileName)
+std::string replaceGraphExtension(std::string_view graphFileName, std::string_view extension)
 {
-    FbxNode* rootNode = pScene->GetRootNode();
+    constexpr GraphFormat Formats[] = { GraphFormat::Dot, GraphFormat::Json, GraphFormat::GraphMl, GraphFormat::EdgeList };
+
+    std::string fileName(graphFileName);
+    fileName.resize(fileName.size() - compressionExtension(compressionFromFileName(fileName)).size());
+    for (const auto format : Formats) {
+        const std::string_view graphExtension = graphFormatExtension(format);
+        if (fileName.size() >= graphExtension.size() && fileName.compare(fileName.size() - graphExtension.size(), graphExtension.size(), graphExtension) == 0) {
+            fileName.resize(fileName.size() - graphExtension.size());
+            break;
+        }
+    }
 
-    if (rootNode) {
+    return fileName.append(extension);
+}
 
-        DGraph dGraph("dag_scene");
-        
-        // root node ( graph )
-        auto dgRoot = createNode(dGraph, rootNode->GetName(), getAttrName(rootNode));
-            
-        for(auto i=0; i < rootNode->GetChildCount(); ++i) {
+std::vector<std::string> outputFileNames(const std::string& dagFile, const std::string& animStackFile, const Options& options)
+{
+    const auto extension = fmt::format("{}{}", graphFormatExtension(options.format), compressionExtension(options.compression));
+
+    std::vector<std::string> fileNames{ replaceGraphExtension(dagFile, extension), replaceGraphExtension(animStackFile, extension) };
+    if (options.snapshot) {
+        fileNames.push_back(replaceGraphExtension(dagFile, ".fvs"));
+        fileNames.push_back(replaceGraphExtension(animStackFile, ".fvs"));
+    }
+    if (options.svg) {
+        fileNames.push_back(replaceGraphExtension(dagFile, ".svg"));
+    }
+    if (options.sample) {
+        fileNames.push_back(sampleFileName(animStackFile, options));
+    }
+
+    return fileNames;
+}
+
+FlatScene::Index findRootNode(const FlatScene& scene, const Options& options)
+{
+    const auto root = NodeFilter(options).findRoot(scene);
+    if (root == FlatScene::None) {
+        fmt::print("Error: no node at --root path {}!\n", options.root);
+    }
+
+    return root;
+}
 
-            auto childNode = createNode(dGraph, rootNode->GetChild(i)->GetName(), getAttrName(rootNode->GetChild(i)));
-            createEdge(dGraph, dgRoot, childNode);
+bool dumpSceneToFile(const FlatScene& scene, FlatScene::Index root, std::string_view fileName, const Options& options, Profile* profile)
+{
+    if (root == FlatScene::None) {
+        return false;
+    }
+
+    NodeFilter filter(options);
+
+    SceneAnnotations annotations;
+    if (options.motionBounds) {
+        Profile::Scope scope(profile, Phase::MotionBounds, computesOnCallingThread(options));
+        annotations.motionBounds = computeMotionBounds(scene, options);
+    }
+    if (options.meshStats) {
+        Profile::Scope scope(profile, Phase::MeshStats, computesOnCallingThread(options));
+        annotations.meshStats = computeSceneMeshStats(scene, options.jobs);
+    }
 
-            traverseNode(dGraph, rootNode->GetChild(i));
+    if (options.streaming) {
+        Profile::Scope scope(profile, Phase::DagTraversal, writesOnCallingThread(options));
+        GraphStreamWriter writer(fileName, "dag_scene", options.format, DotStyle::Dag);
+        buildSceneGraph(writer, scene, root, filter, annotations);
+        writer.close();
+
+        if (profile) {
+            profile->count(Counter::Nodes, writer.nodeCount());
+            profile->count(Counter::Edges, writer.edgeCount());
         }
+        return true;
+    }
+
+    DGraph dGraph("dag_scene");
+    {
+        Profile::Scope scope(profile, Phase::DagTraversal);
+        buildSceneGraph(dGraph, scene, root, filter, annotations);
+    }
+
+    Profile::Scope scope(profile, Phase::Serialize, writesOnCallingThread(options));
+    dGraph.dumpDag(fileName, options.format);
 
-        dGraph.dumpDag(fileName);
+    if (options.snapshot) {
+        dGraph.dumpSnapshot(replaceGraphExtension(fileName, ".fvs"), {});
     }
+
+    if (options.svg) {
+        dGraph.dumpSvg(replaceGraphExtension(fileName, ".svg"));
+    }
+
+    if (profile) {
+        profile->count(Counter::Nodes, dGraph.getNodes().size());
+        profile->count(Counter::Edges, dGraph.getEdges().size());
+    }
+
+    return true;
 }
 
-void dumpAnimStackToFile(FbxScene* pScene, std::string_view fileName)
+bool dumpAnimStackToFile(const FlatScene& scene, FlatScene::Index root, std::string_view fileName, const Options& options, Profile* profile)
 {
-    FbxNode* rootNode = pScene->GetRootNode();
+    if (root == FlatScene::None) {
+        return false;
+    }
+
+    NodeFilter filter(options);
 
-    if (rootNode) {
+    AnimStackOutput output;
+    if (options.streaming) {
+        Profile::Scope scope(profile, Phase::AnimStackTraversal, computesOnCallingThread(options) && writesOnCallingThread(options));
+        GraphStreamWriter writer(fileName, "dag_animstack", options.format, DotStyle::AnimStack);
+        buildAnimStackGraph(writer, scene, root, filter, options, output);
+        writer.close();
 
+        if (profile) {
+            profile->count(Counter::Nodes, writer.nodeCount());
+            profile->count(Counter::Edges, writer.edgeCount());
+        }
+    } else {
         DGraph dGraph("dag_animstack");
-        
-        for (auto i = 0; i < pScene->GetSrcObjectCount<FbxAnimStack>(); i++) {
+        {
+            Profile::Scope scope(profile, Phase::AnimStackTraversal, computesOnCallingThread(options));
+            if (workerCount(options.jobs) > 1) {
+                buildAnimStackGraphParallel(dGraph, scene, root, filter, options, output);
+            } else {
+                buildAnimStackGraph(dGraph, scene, root, filter, options, output);
+            }
+        }
 
-            FbxAnimStack* animStack = pScene->GetSrcObject<FbxAnimStack>(i);
-        
-            // animation stack node ( graph )
-            auto animStackNode = createNode(dGraph, animStack->GetName(), "AnimationStack");
+        Profile::Scope scope(profile, Phase::Serialize, writesOnCallingThread(options));
+        dGraph.dumpAnimStack(fileName, options.format);
+
+        if (options.snapshot) {
+            // curve nodes are found by key, merging renumbers them
+            std::vector<SnapshotCurve> curves;
+            curves.reserve(output.curves.size());
+            for (const auto& kept : output.curves) {
+                SnapshotCurve curve;
+                curve.node = dGraph.findNode(kept.key);
+                curve.keyCount = kept.snapshot.keyCount();
+                curve.times = kept.snapshot.times.data();
+                curve.values = kept.snapshot.values.data();
+                curve.leftDerivatives = kept.snapshot.leftDerivatives.data();
+                curve.rightDerivatives = kept.snapshot.rightDerivatives.data();
+                curve.flags = kept.snapshot.flags.data();
+                curves.push_back(curve);
+            }
 
-            // traverse animation stack
-            for (auto i = 0; i < animStack->GetMemberCount<FbxAnimLayer>(); ++i) {
-                            
-                FbxAnimLayer* animLayer = animStack->GetMember<FbxAnimLayer>(i);
+            dGraph.dumpSnapshot(replaceGraphExtension(fileName, ".fvs"), curves);
+        }
+
+        if (profile) {
+            profile->count(Counter::Nodes, dGraph.getNodes().size());
+            profile->count(Counter::Edges, dGraph.getEdges().size());
+        }
+    }
 
-                auto animLayerNode = createNode(dGraph, animLayer->GetName(), "AnimationLayer");
-                createEdge(dGraph, animStackNode, animLayerNode);
-                
-                traverseAnimationLayer(dGraph, animStack, animLayer, pScene->GetRootNode(), animLayerNode);
+    bool sampled = true;
+    if (options.sample) {
+        Profile::Scope scope(profile, Phase::Sample, computesOnCallingThread(options) && writesOnCallingThread(options));
+
+        // one table per stack over its own time span, the curves are in
+        // stack order. Stacks without curves get no table.
+        std::vector<SampleTable> tables;
+        std::vector<const CurveSnapshot*> curves;
+        for (auto first = output.curves.begin(); first != output.curves.end();) {
+            const auto last = std::find_if(first, output.curves.end(), [&](const KeptCurve& kept) { return kept.animStack != first->animStack; });
+
+            SampleTable table;
+            curves.clear();
+            for (auto kept = first; kept != last; ++kept) {
+                table.channels.push_back({ kept->channel, &kept->snapshot });
+                curves.push_back(&kept->snapshot);
             }
+            table.grid = sampleGrid(first->animStack, curves, options.sampleRate);
+            tables.push_back(std::move(table));
+
+            first = last;
         }
 
-        dGraph.dumpAnimStack(fileName);   
+        sampled = writeSampleTables(sampleFileName(fileName, options), options.sampleFormat, tables, options.jobs);
     }
+
+    if (profile) {
+        profile->count(Counter::Curves, output.curveCount);
+        profile->count(Counter::Keys, output.keyCount);
+    }
+
+    if (options.redundantKeys) {
+        fmt::print("Redundant keys ( tolerance {} ):\n{}", options.redundantKeyTolerance, output.report);
+    }
+
+    return sampled;
+}
+
+void dumpSceneDiffToFile(FbxScene* pBefore, FbxScene* pAfter, std::string_view fileName, GraphFormat format)
+{
+    if (!pBefore->GetRootNode() || !pAfter->GetRootNode()) {
+        return;
+    }
+
+    const auto before = buildSceneHashTree(FlatScene(pBefore));
+    const auto after = buildSceneHashTree(FlatScene(pAfter));
+
+    DGraph dGraph("dag_diff");
+    const auto summary = diffSceneHashTrees(before, after, dGraph);
+    dGraph.dumpDiff(fileName, format);
+
+    fmt::print("Nodes: {} added, {} removed, {} modified. Curves: {} added, {} removed, {} modified. "
+               "Compared {} of {} nodes.\n",
+               summary.addedNodes, summary.removedNodes, summary.modifiedNodes,
+               summary.addedCurves, summary.removedCurves, summary.modifiedCurves,
+               summary.visitedNodes, after.entries.size());
 }
 
 } // fbxViz namespace
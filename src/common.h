@@ -23,17 +23,45 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
+#include "flatScene.h"
+#include "options.h"
+#include "profile.h"
+
 #include <fbxsdk.h>
 
+#include <string>
 #include <string_view>
+#include <vector>
 
 namespace fbxViz {
 
 bool initialize(FbxManager*& pManager, FbxScene*& pScene);
 void destroy(FbxManager* pManager);
-bool loadScene(FbxManager* pManager, FbxDocument* pScene, std::string_view pFilename);
+// imports the file and runs the checks of a synchronous validation mode,
+// see sceneValidation.h. The phases are recorded when a profile is given.
+bool loadScene(FbxManager* pManager, FbxDocument* pScene, std::string_view pFilename,
+               ValidationMode validation = ValidationMode::Full, Profile* profile = nullptr);
+
+// "dag.dot", ".fvs" -> "dag.fvs", strips the extension of any graph format
+// and compression, "dag.dot.gz" gives "dag.fvs" too
+std::string replaceGraphExtension(std::string_view graphFileName, std::string_view extension);
+
+// the files written for one input: the graphs, named by --format and
+// --compress, and with --snapshot their binary snapshots and with --svg the
+// drawing of the hierarchy
+std::vector<std::string> outputFileNames(const std::string& dagFile, const std::string& animStackFile, const Options& options);
+
+// the node the --root path names, the scene root without one. Prints an
+// error and returns FlatScene::None when the path does not exist.
+FlatScene::Index findRootNode(const FlatScene& scene, const Options& options);
+
+// dump the subtree of root, as found by findRootNode(). Return false when
+// there is no such node and nothing was written.
+bool dumpSceneToFile(const FlatScene& scene, FlatScene::Index root, std::string_view fileName, const Options& options, Profile* profile = nullptr);
+bool dumpAnimStackToFile(const FlatScene& scene, FlatScene::Index root, std::string_view fileName, const Options& options, Profile* profile = nullptr);
 
-void dumpSceneToFile(FbxScene* pScene, std::string_view fileName);
-void dumpAnimStackToFile(FbxScene*, std::string_view fileName);
+// compares the hierarchies, transforms and curves of two scenes and writes
+// the added, removed and modified nodes and curves
+void dumpSceneDiffToFile(FbxScene* pBefore, FbxScene* pAfter, std::string_view fileName, GraphFormat format = GraphFormat::Dot);
 
 } // namespace fbxViz
@@ -1,118 +1,125 @@
 #include "curveInfo.h"
+#include "curveStats.h"
 
-#include <fmt/core.h>
+#include "graph/nodeData.h"
 
-#include <fstream>
+#include <algorithm>
 
 namespace {
 
 // Key interpolation type
-std::string getKeyInterpolationType( FbxAnimCurve* animCurve, int keyIndex ) {
-    switch ( animCurve->KeyGetInterpolation( keyIndex ) ) {
+fbxViz::KeyInterpolation toKeyInterpolation( FbxAnimCurveDef::EInterpolationType type ) {
+    switch ( type ) {
     case FbxAnimCurveDef::eInterpolationConstant:
-        return "constant"; // Animation Curve value stays the same until next key
-
-        break;
+        return fbxViz::KeyInterpolation::Constant; // Animation Curve value stays the same until next key
 
     case FbxAnimCurveDef::eInterpolationLinear:
-        return "linear"; // Animation curve is a straight line
-
-        break;
+        return fbxViz::KeyInterpolation::Linear; // Animation curve is a straight line
 
     case FbxAnimCurveDef::eInterpolationCubic:
-        return "cubic"; // Animation curve is a Bezier spline
-
-        break;
+        return fbxViz::KeyInterpolation::Cubic; // Animation curve is a Bezier spline
 
     default:
-        return "?";
+        return fbxViz::KeyInterpolation::Unknown;
     }
 }
 
-// Key Tangent Mode. This method is meaningful for cubic interpolation only.
-// Using this method for non cubic interpolated key will return unpredictable value.
-std::string getKeyTangentMode( FbxAnimCurve* animCurve, int keyIndex ) {
-
-    switch ( animCurve->KeyGetTangentMode( keyIndex ) ) {
+// Key Tangent Mode. This is meaningful for cubic interpolation only.
+// For non cubic interpolated keys the value is unpredictable.
+fbxViz::KeyTangentMode toKeyTangentMode( FbxAnimCurveDef::ETangentMode mode ) {
+    switch ( mode ) {
     case FbxAnimCurveDef::eTangentAuto:
-        return "Auto"; // Spline cardinal
-
-        break;
+        return fbxViz::KeyTangentMode::Auto; // Spline cardinal
 
     case FbxAnimCurveDef::eTangentAutoBreak:
-        return "AutoBreak";
-
-        break;
+        return fbxViz::KeyTangentMode::AutoBreak;
 
     case FbxAnimCurveDef::eTangentTCB:
-        return "TCB"; // Tension, Continuity, Bias
-
-        break;
+        return fbxViz::KeyTangentMode::TCB; // Tension, Continuity, Bias
 
     case FbxAnimCurveDef::eTangentUser:
-        return "User"; // Next slope at the left equal to slope at the right
-
-        break;
+        return fbxViz::KeyTangentMode::User; // Next slope at the left equal to slope at the right
 
     case FbxAnimCurveDef::eTangentGenericBreak:
-        return "GenericBreak";
-
-        break;
+        return fbxViz::KeyTangentMode::GenericBreak;
 
     case FbxAnimCurveDef::eTangentBreak:
-        return "Break";
-
-        break;
+        return fbxViz::KeyTangentMode::Break;
 
     default:
-        return "?";
+        return fbxViz::KeyTangentMode::Unknown;
     }
 }
 
-// Get key's tangent weight mode. This method is meaningful for cubic interpolation only.
-std::string getTangentweight( FbxAnimCurve* animCurve, int keyIndex ) {
-    switch ( animCurve->KeyGet( keyIndex ).GetTangentWeightMode() ) {
-    case FbxAnimCurveDef::eWeightedNone:
-        return "None"; // Tangent has default weights of 0.333; we define this state as not weighted.
-
-        break;
-
+// Key's tangent weight mode. This is meaningful for cubic interpolation only.
+fbxViz::KeyTangentWeight toKeyTangentWeight( FbxAnimCurveDef::EWeightedMode mode ) {
+    switch ( mode ) {
     case FbxAnimCurveDef::eWeightedRight:
-        return "WeightedRight"; // Right tangent is weighted.
-
-        break;
+        return fbxViz::KeyTangentWeight::Right; // Right tangent is weighted.
 
     case FbxAnimCurveDef::eWeightedNextLeft:
-        return "WeightedNextLeft"; // Left tangent is weighted.
-
-        break;
+        return fbxViz::KeyTangentWeight::NextLeft; // Left tangent is weighted.
 
     case FbxAnimCurveDef::eWeightedAll:
-        return "WeightedAll"; // Both left and right tangents are weighted
-
-        break;
+        return fbxViz::KeyTangentWeight::All; // Both left and right tangents are weighted
 
     default:
-        return "?";
+        return fbxViz::KeyTangentWeight::None; // Tangent has default weights of 0.333; we define this state as not weighted.
     }
 }
 
-// Get key's constant mode. This method is only relevant if the key's interpolation
+// Key's constant mode. This is only relevant if the key's interpolation
 // type is constant (eInterpolationConstant).
-std::string getKeyConstantMode( FbxAnimCurve* animCurve, int keyIndex ) {
-    switch ( animCurve->KeyGetConstantMode( keyIndex ) ) {
-    case FbxAnimCurveDef::eConstantStandard:
-        return "ConstantStandard";  // Curve value is constant between this key and the next.
+fbxViz::KeyConstantMode toKeyConstantMode( FbxAnimCurveDef::EConstantMode mode ) {
+    return mode == FbxAnimCurveDef::eConstantNext ? fbxViz::KeyConstantMode::Next    // Curve value is constant, with next key's value.
+                                                  : fbxViz::KeyConstantMode::Standard; // Curve value is constant between this key and the next.
+}
 
-        break;
+void appendKeyRow( fbxViz::NodeDataBuilder& data, const fbxViz::CurveSnapshot& snapshot, std::size_t keyIndex ) {
 
-    case FbxAnimCurveDef::eConstantNext:
-        return "ConstantNext";     // Curve value is constant, with next key's value.
+    char timeString[256];
+    FbxTime( snapshot.times[keyIndex] ).GetTimeString( timeString, sizeof( timeString ) );
 
-        break;
+    const auto keyInterpolationType = snapshot.interpolation( keyIndex );
 
-    default:
-        return "?";
+    data.row()
+        .field( "Key Time", timeString )
+        .field( "Key Value", static_cast<double>( snapshot.values[keyIndex] ) )
+        .field( "InterpolationType", fbxViz::interpolationName( keyInterpolationType ) );
+
+    if ( keyInterpolationType == fbxViz::KeyInterpolation::Cubic ) {
+        data.field( "TangentMode", fbxViz::tangentModeName( snapshot.tangentMode( keyIndex ) ) )
+            .field( "TangentWeight", fbxViz::tangentWeightName( snapshot.tangentWeight( keyIndex ) ) );
+    } else if ( keyInterpolationType == fbxViz::KeyInterpolation::Constant ) {
+        data.field( "ConstantMode", fbxViz::constantModeName( snapshot.constantMode( keyIndex ) ) );
+    }
+}
+
+void appendSummaryRows( fbxViz::NodeDataBuilder& data, const fbxViz::CurveStats& stats ) {
+
+    if ( stats.keyCount == 0 ) {
+        return;
+    }
+
+    char startString[256];
+    char stopString[256];
+    FbxTime( stats.startTime ).GetTimeString( startString, sizeof( startString ) );
+    FbxTime( stats.stopTime ).GetTimeString( stopString, sizeof( stopString ) );
+
+    data.row()
+        .field( "Time Span Start", startString )
+        .field( "Time Span Stop", stopString );
+
+    data.row()
+        .field( "Min", static_cast<double>( stats.minValue ) )
+        .field( "Max", static_cast<double>( stats.maxValue ) )
+        .field( "Mean", stats.meanValue );
+
+    data.row();
+    for ( std::size_t i = 0; i < stats.interpolationCounts.size(); ++i ) {
+        if ( stats.interpolationCounts[i] != 0 ) {
+            data.field( fbxViz::interpolationName( static_cast<fbxViz::KeyInterpolation>( i ) ), stats.interpolationCounts[i] );
+        }
     }
 }
 
@@ -120,63 +127,72 @@ std::string getKeyConstantMode( FbxAnimCurve* animCurve, int keyIndex ) {
 
 namespace fbxViz {
 
-std::string getCurveAnimKeyInfo( FbxAnimCurve* animCurve ) {
+CurveSnapshot extractCurve( FbxAnimCurve* animCurve ) {
 
-    std::string outputStr;
-    char timeString[256];
+    CurveSnapshot snapshot;
 
     const auto keyCount = animCurve->KeyGetCount();
-    outputStr = "<tr><td align='left'><b>";
-    outputStr += "Key counts= ";
-    outputStr += "<font color='red'><b>";
-    outputStr += std::to_string( keyCount );
-    outputStr += "</b></font>";
-    outputStr += "</b></td></tr>\n";
+    snapshot.reserve( keyCount );
 
     for ( auto keyIndex = 0; keyIndex < keyCount; ++keyIndex ) {
-        auto keyTime = animCurve->KeyGetTime( keyIndex );
-        auto keyValue = animCurve->KeyGetValue( keyIndex );
-        auto keyInterpolationType = getKeyInterpolationType( animCurve, keyIndex );
-
-        outputStr += "<tr><td align='left'>";
-        outputStr += "Key Time= ";
-        outputStr += "<font color='red'><b>";
-        outputStr += keyTime.GetTimeString( timeString, sizeof( timeString ) );
-        outputStr += "</b></font>";
-        outputStr += " , ";
-        outputStr += "Key Value= ";
-        outputStr += "<font color='red'><b>";
-        outputStr += std::to_string( keyValue );
-        outputStr += "</b></font>";
-
-        outputStr += " , ";
-        outputStr += "InterpolationType= ";
-        outputStr += "<font color='red'><b>";
-        outputStr += keyInterpolationType;
-        outputStr += "</b></font>";
-
-        if ( "cubic" == keyInterpolationType ) {
-            outputStr += " , ";
-            outputStr += "TangentMode= ";
-            outputStr += "<font color='red'><b>";
-            outputStr += getKeyTangentMode( animCurve, keyIndex );
-            outputStr += "</b></font>";
-            outputStr += ", ";
-            outputStr += "TangentWeight= ";
-            outputStr += "<font color='red'><b>";
-            outputStr += getTangentweight( animCurve, keyIndex );
-            outputStr += "</b></font>";
-        } else if ( "constant" == keyInterpolationType ) {
-            outputStr += " , ";
-            outputStr += "<font color='red'><b>";
-            outputStr += getKeyConstantMode( animCurve, keyIndex );
-            outputStr += "</b></font>";
-            outputStr += ", ";
-        }
-        outputStr += "</td></tr>\n";
+        const auto key = animCurve->KeyGet( keyIndex );
+
+        const auto flags = CurveSnapshot::packFlags( toKeyInterpolation( key.GetInterpolation() ),
+                                                     toKeyTangentMode( key.GetTangentMode() ),
+                                                     toKeyTangentWeight( key.GetTangentWeightMode() ),
+                                                     toKeyConstantMode( key.GetConstantMode() ) );
+
+        snapshot.addKey( key.GetTime().Get(),
+                         key.GetValue(),
+                         animCurve->KeyGetLeftDerivative( keyIndex ),
+                         animCurve->KeyGetRightDerivative( keyIndex ),
+                         flags );
+    }
+
+    return snapshot;
+}
+
+std::string getCurveAnimKeyInfo( const CurveSnapshot& snapshot, const CurveDetail& detail ) {
+
+    std::string outputStr;
+    NodeDataBuilder data( outputStr );
+
+    const auto keyCount = snapshot.keyCount();
+    data.row().field( "Key counts", keyCount );
+
+    if ( detail.mode == CurveDetail::Mode::Summary ) {
+        appendSummaryRows( data, computeCurveStats( snapshot ) );
+        return outputStr;
+    }
+
+    auto rowCount = keyCount;
+    if ( detail.mode == CurveDetail::Mode::Rows ) {
+        rowCount = std::min( rowCount, detail.maxRows );
+    }
+
+    for ( std::size_t keyIndex = 0; keyIndex < rowCount; ++keyIndex ) {
+        appendKeyRow( data, snapshot, keyIndex );
+    }
+
+    if ( rowCount < keyCount ) {
+        data.row().field( "More keys", keyCount - rowCount );
     }
 
     return outputStr;
 }
 
+std::string getKeyRedundancyInfo( const KeyRedundancy& redundancy ) {
+
+    std::string outputStr;
+    NodeDataBuilder( outputStr ).row()
+        .field( "Redundant Keys", redundancy.removable() )
+        .field( "Total Keys", redundancy.keyCount )
+        .field( "Percent", redundancy.percent(), 1 )
+        .field( "Constant", redundancy.constant )
+        .field( "Linear", redundancy.linear )
+        .field( "Cubic", redundancy.cubic );
+
+    return outputStr;
+}
+
 } // namespace fbxViz
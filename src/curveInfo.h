@@ -23,11 +23,22 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
+#include "curveRedundancy.h"
+#include "curveSnapshot.h"
+#include "options.h"
+
 #include <string>
 #include <fbxsdk.h>
 
 namespace fbxViz {
 
-std::string getCurveAnimKeyInfo( FbxAnimCurve* animCurve );
+// reads every key of the curve from the SDK once
+CurveSnapshot extractCurve( FbxAnimCurve* animCurve );
+
+// data rows of the curve node, see CurveDetail and graph/nodeData.h
+std::string getCurveAnimKeyInfo( const CurveSnapshot& snapshot, const CurveDetail& detail );
+
+// data row with the removable keys of a curve or a whole layer
+std::string getKeyRedundancyInfo( const KeyRedundancy& redundancy );
 
 } // namespace fbxViz
@@ -0,0 +1,118 @@
+#include "curveRedundancy.h"
+
+#include <cmath>
+#include <vector>
+
+namespace {
+
+    // FbxTime ticks per second
+    constexpr double TicksPerSecond = 46186158000.0;
+
+    constexpr std::uint8_t InterpolationMask = 0x03;
+    constexpr std::uint8_t WeightMask = 0x60;
+    constexpr std::uint8_t ConstantNextBit = 0x80;
+
+    constexpr std::uint8_t ConstantKey = static_cast<std::uint8_t>(fbxViz::KeyInterpolation::Constant);
+    constexpr std::uint8_t LinearKey = static_cast<std::uint8_t>(fbxViz::KeyInterpolation::Linear);
+    constexpr std::uint8_t CubicKey = static_cast<std::uint8_t>(fbxViz::KeyInterpolation::Cubic);
+
+} // namespace
+
+namespace fbxViz {
+
+double KeyRedundancy::percent() const
+{
+    return keyCount ? 100.0 * static_cast<double>(removable()) / static_cast<double>(keyCount) : 0.0;
+}
+
+KeyRedundancy& KeyRedundancy::operator+=(const KeyRedundancy& other)
+{
+    keyCount += other.keyCount;
+    constant += other.constant;
+    linear += other.linear;
+    cubic += other.cubic;
+    return *this;
+}
+
+KeyRedundancy findRedundantKeys(const CurveSnapshot& snapshot, float tolerance)
+{
+    KeyRedundancy result;
+
+    const auto keyCount = snapshot.keyCount();
+    result.keyCount = keyCount;
+    if (keyCount < 3) {
+        return result;
+    }
+
+    // key times in seconds, derivatives are per second
+    std::vector<double> seconds(keyCount);
+    for (std::size_t i = 0; i < keyCount; ++i) {
+        seconds[i] = static_cast<double>(snapshot.times[i]) / TicksPerSecond;
+    }
+
+    const auto* t = seconds.data();
+    const auto* v = snapshot.values.data();
+    const auto* left = snapshot.leftDerivatives.data();
+    const auto* right = snapshot.rightDerivatives.data();
+    const auto* flags = snapshot.flags.data();
+    const double tol = tolerance;
+
+    std::size_t constant = 0, linear = 0, cubic = 0;
+
+    // branch free so the key loop vectorizes, every test is evaluated and
+    // masked by the interpolation of the two segments around the key
+    for (std::size_t i = 1; i + 1 < keyCount; ++i) {
+        const unsigned prevInterpolation = flags[i - 1] & InterpolationMask;
+        const unsigned interpolation = flags[i] & InterpolationMask;
+        const bool sameInterpolation = prevInterpolation == interpolation;
+
+        const double span = t[i + 1] - t[i - 1];
+        const double leftSpan = t[i] - t[i - 1];
+        const double rightSpan = t[i + 1] - t[i];
+        // keys never share a time, the guard only keeps the division safe
+        const double invSpan = 1.0 / (span > 0.0 ? span : 1.0);
+        const double s = leftSpan * invSpan;
+
+        const double v0 = v[i - 1];
+        const double v1 = v[i + 1];
+        const double vi = v[i];
+
+        // constant: the previous key already holds this value
+        const bool standardHold = ((flags[i - 1] | flags[i]) & ConstantNextBit) == 0;
+        const bool isConstant = sameInterpolation & (interpolation == ConstantKey) & standardHold
+                              & (std::fabs(vi - v0) <= tol);
+
+        // linear: the key lies on the line between its neighbours
+        const double lerp = v0 + (v1 - v0) * s;
+        const bool isLinear = sameInterpolation & (interpolation == LinearKey)
+                            & (std::fabs(vi - lerp) <= tol);
+
+        // cubic: the hermite segment between the neighbours passes through
+        // the key with the key's own tangents. Weighted tangents are kept.
+        const double m0 = right[i - 1] * span;
+        const double m1 = left[i + 1] * span;
+        const double s2 = s * s;
+        const double s3 = s2 * s;
+        const double hermite = (2.0 * s3 - 3.0 * s2 + 1.0) * v0 + (s3 - 2.0 * s2 + s) * m0
+                             + (-2.0 * s3 + 3.0 * s2) * v1 + (s3 - s2) * m1;
+        const double slope = ((6.0 * s2 - 6.0 * s) * v0 + (3.0 * s2 - 4.0 * s + 1.0) * m0
+                             + (-6.0 * s2 + 6.0 * s) * v1 + (3.0 * s2 - 2.0 * s) * m1) * invSpan;
+        const double shortSpan = leftSpan < rightSpan ? leftSpan : rightSpan;
+        const bool unweighted = ((flags[i - 1] | flags[i]) & WeightMask) == 0;
+        const bool isCubic = sameInterpolation & (interpolation == CubicKey) & unweighted
+                           & (std::fabs(vi - hermite) <= tol)
+                           & (std::fabs(left[i] - slope) * shortSpan <= tol)
+                           & (std::fabs(right[i] - slope) * shortSpan <= tol);
+
+        constant += isConstant;
+        linear += isLinear;
+        cubic += isCubic;
+    }
+
+    result.constant = constant;
+    result.linear = linear;
+    result.cubic = cubic;
+    return result;
+}
+
+} // namespace fbxViz
@@ -0,0 +1,52 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "curveSnapshot.h"
+
+#include <cstddef>
+
+namespace fbxViz {
+
+// interior keys of a curve that can be removed without changing its shape
+// by more than the tolerance, grouped by the reason they are redundant
+struct KeyRedundancy
+{
+    std::size_t keyCount{0};
+    std::size_t constant{0};    // same value as the held previous key
+    std::size_t linear{0};      // on the line between its neighbours
+    std::size_t cubic{0};       // splits the spline between its neighbours
+
+    std::size_t removable() const { return constant + linear + cubic; }
+    double percent() const;
+
+    KeyRedundancy& operator+=(const KeyRedundancy& other);
+};
+
+// every interior key is tested against its two neighbours of the original
+// curve. The tolerance is in curve value units, tangents are compared over
+// the length of the shorter segment.
+KeyRedundancy findRedundantKeys(const CurveSnapshot& snapshot, float tolerance);
+
+} // namespace fbxViz
@@ -0,0 +1,230 @@
+#include "curveSampler.h"
+#include "parallel.h"
+
+#include "graph/outputBuffer.h"
+
+#include <algorithm>
+#include <cmath>
+#include <iterator>
+#include <type_traits>
+
+namespace {
+
+    // FbxTime ticks per second
+    constexpr double TicksPerSecond = 46186158000.0;
+
+    // frames sampled per pass, the block of every channel stays in memory
+    // until its rows are written
+    constexpr std::size_t BlockFrames = 4096;
+
+    constexpr std::uint8_t InterpolationMask = 0x03;
+    constexpr std::uint8_t ConstantNextBit = 0x80;
+
+    constexpr std::uint8_t ConstantKey = static_cast<std::uint8_t>(fbxViz::KeyInterpolation::Constant);
+    constexpr std::uint8_t LinearKey = static_cast<std::uint8_t>(fbxViz::KeyInterpolation::Linear);
+
+    template <typename T>
+    void writeValue(fbxViz::OutputBuffer& out, const T& value)
+    {
+        static_assert(std::is_trivially_copyable<T>::value, "the table is written byte wise");
+        out.write(std::string_view(reinterpret_cast<const char*>(&value), sizeof(T)));
+    }
+
+    // quoted when the name would break the row
+    void writeCsvName(fbxViz::OutputBuffer& out, std::string_view name)
+    {
+        if (name.find_first_of(",\"\n") == std::string_view::npos) {
+            out.write(name);
+            return;
+        }
+
+        out.put('"');
+        for (auto c : name) {
+            if (c == '"') {
+                out.put('"');
+            }
+            out.put(c);
+        }
+        out.put('"');
+    }
+
+    void writeHeader(fbxViz::OutputBuffer& out, fbxViz::SampleFormat format, const fbxViz::SampleGrid& grid,
+                     const std::vector<fbxViz::SampleChannel>& channels)
+    {
+        if (format == fbxViz::SampleFormat::Csv) {
+            out.write("time");
+            for (const auto& channel : channels) {
+                out.put(',');
+                writeCsvName(out, channel.name);
+            }
+            out.put('\n');
+            return;
+        }
+
+        fbxViz::SampleTableHeader header{};
+        std::copy(std::begin(fbxViz::SampleTableMagic), std::end(fbxViz::SampleTableMagic), header.magic);
+        header.version = fbxViz::SampleTableVersion;
+        header.byteOrderMark = 0x01020304;
+        header.channelCount = static_cast<std::uint32_t>(channels.size());
+        header.frameCount = grid.frameCount();
+        header.startTime = grid.start;
+        header.frameRate = grid.frameRate;
+        writeValue(out, header);
+
+        for (const auto& channel : channels) {
+            writeValue(out, static_cast<std::uint32_t>(channel.name.size()));
+            out.write(channel.name);
+        }
+    }
+
+    // the block is channel major, `stride` floats per channel
+    void writeRows(fbxViz::OutputBuffer& out, fbxViz::SampleFormat format, const std::int64_t* times, std::size_t frameCount,
+                   const std::vector<float>& block, std::size_t channelCount, std::size_t stride)
+    {
+        for (std::size_t frame = 0; frame < frameCount; ++frame) {
+            if (format == fbxViz::SampleFormat::Csv) {
+                out.format("{:.6f}", static_cast<double>(times[frame]) / TicksPerSecond);
+                for (std::size_t channel = 0; channel < channelCount; ++channel) {
+                    out.format(",{}", block[channel * stride + frame]);
+                }
+                out.put('\n');
+            } else {
+                for (std::size_t channel = 0; channel < channelCount; ++channel) {
+                    writeValue(out, block[channel * stride + frame]);
+                }
+            }
+        }
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+std::size_t SampleGrid::frameCount() const
+{
+    if (stop < start || frameRate <= 0.0) {
+        return 0;
+    }
+
+    // a frame that lands on stop up to rounding is kept
+    const double frames = static_cast<double>(stop - start) * frameRate / TicksPerSecond;
+    return static_cast<std::size_t>(std::floor(frames + 1e-6)) + 1;
+}
+
+std::int64_t SampleGrid::time(std::size_t frame) const
+{
+    return start + std::llround(static_cast<double>(frame) * TicksPerSecond / frameRate);
+}
+
+void sampleCurve(const CurveSnapshot& curve, const std::int64_t* times, std::size_t count, float* values, std::size_t& key)
+{
+    const auto keyCount = curve.keyCount();
+    if (keyCount == 0) {
+        std::fill(values, values + count, 0.0f);
+        return;
+    }
+
+    const auto* t = curve.times.data();
+    const auto* v = curve.values.data();
+    const auto* left = curve.leftDerivatives.data();
+    const auto* right = curve.rightDerivatives.data();
+    const auto* flags = curve.flags.data();
+
+    const auto last = keyCount - 1;
+    for (std::size_t i = 0; i < count; ++i) {
+        const auto time = times[i];
+
+        // the segment [key, key + 1] holding the time
+        while (key < last && t[key + 1] <= time) {
+            ++key;
+        }
+
+        if (time <= t[0]) {
+            values[i] = v[0];
+            continue;
+        }
+        if (key == last) {
+            values[i] = v[last];
+            continue;
+        }
+
+        const auto interpolation = flags[key] & InterpolationMask;
+        if (interpolation == ConstantKey) {
+            values[i] = (flags[key] & ConstantNextBit) ? v[key + 1] : v[key];
+            continue;
+        }
+
+        const double span = static_cast<double>(t[key + 1] - t[key]);
+        const double s = static_cast<double>(time - t[key]) / span;
+        const double v0 = v[key];
+        const double v1 = v[key + 1];
+
+        if (interpolation == LinearKey) {
+            values[i] = static_cast<float>(v0 + (v1 - v0) * s);
+            continue;
+        }
+
+        // derivatives are per second, the tangents span the segment
+        const double seconds = span / TicksPerSecond;
+        const double m0 = right[key] * seconds;
+        const double m1 = left[key + 1] * seconds;
+        const double s2 = s * s;
+        const double s3 = s2 * s;
+        values[i] = static_cast<float>((2.0 * s3 - 3.0 * s2 + 1.0) * v0 + (s3 - 2.0 * s2 + s) * m0
+                                       + (-2.0 * s3 + 3.0 * s2) * v1 + (s3 - s2) * m1);
+    }
+}
+
+bool writeSampleTables(std::string_view fileName, SampleFormat format, const std::vector<SampleTable>& tables, unsigned jobs)
+{
+    OutputBuffer out(fileName, OutputBuffer::DefaultCapacity, compressionFromFileName(fileName));
+    if (!out.isOpen()) {
+        return false;
+    }
+
+    std::size_t channelTotal = 0;
+    std::size_t frameTotal = 0;
+    for (const auto& table : tables) {
+        if (format == SampleFormat::Csv && &table != &tables.front()) {
+            out.put('\n');
+        }
+
+        writeHeader(out, format, table.grid, table.channels);
+
+        const auto& grid = table.grid;
+        const auto& channels = table.channels;
+        const auto frameCount = grid.frameCount();
+        const auto channelCount = channels.size();
+        const auto stride = std::min(frameCount, BlockFrames);
+
+        std::vector<std::int64_t> times(stride);
+        std::vector<float> block(channelCount * stride);
+        std::vector<std::size_t> cursors(channelCount, 0);
+
+        for (std::size_t first = 0; first < frameCount; first += stride) {
+            const auto blockFrames = std::min(stride, frameCount - first);
+            for (std::size_t frame = 0; frame < blockFrames; ++frame) {
+                times[frame] = grid.time(first + frame);
+            }
+
+            // every channel has its own column of the block and its own cursor
+            parallelFor(channelCount, jobs, [&](std::size_t channel) {
+                sampleCurve(*channels[channel].curve, times.data(), blockFrames, block.data() + channel * stride, cursors[channel]);
+            });
+
+            writeRows(out, format, times.data(), blockFrames, block, channelCount, stride);
+        }
+
+        channelTotal += channelCount;
+        frameTotal += frameCount;
+    }
+
+    out.close();
+
+    constexpr double MegaByte = 1024.0 * 1024.0;
+    fmt::print("Sampled {} curves of {} animation stacks at {} frames to {} successfully!!! ({:.2f} MB)\n",
+               channelTotal, tables.size(), frameTotal, out.fileName(), out.bytesWritten() / MegaByte);
+    return true;
+}
+
+} // namespace fbxViz
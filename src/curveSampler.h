@@ -0,0 +1,100 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "curveSnapshot.h"
+#include "options.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace fbxViz {
+
+// frames at a fixed rate from start to stop, both included. Times are
+// FbxTime ticks.
+struct SampleGrid
+{
+    std::int64_t start{0};
+    std::int64_t stop{0};
+    double frameRate{30.0};
+
+    std::size_t frameCount() const;
+    std::int64_t time(std::size_t frame) const;
+};
+
+// one column of the table, the name and the curve are not copied
+struct SampleChannel
+{
+    std::string_view name;
+    const CurveSnapshot* curve;
+};
+
+// the channels of one animation stack, sampled over the grid of that stack
+struct SampleTable
+{
+    SampleGrid grid;
+    std::vector<SampleChannel> channels;
+};
+
+// evaluates the curve at ascending times. The keys are walked alongside the
+// times instead of being searched for every time, `key` keeps the position
+// between calls and starts at 0. Constant, linear and cubic segments are
+// evaluated from the extracted keys, cubic ones as Hermite splines of the
+// key derivatives. Tangent weights are not extracted, weighted segments are
+// evaluated unweighted. Before the first and after the last key the curve
+// holds the value of that key.
+void sampleCurve(const CurveSnapshot& curve, const std::int64_t* times, std::size_t count, float* values, std::size_t& key);
+
+// a file holds one table per animation stack, back to back until the end
+// of the file. Every table starts with the magic, the version and the byte
+// order mark, followed by the SampleTableHeader fields, the channel names
+// ( uint32 size, name ) and frameCount rows of channelCount floats, in the
+// byte order of the writer. The time of a row is
+// startTime + frame * 46186158000 / frameRate ticks.
+constexpr char SampleTableMagic[8] = { 'F', 'B', 'X', 'V', 'I', 'Z', 'S', '\0' };
+constexpr std::uint32_t SampleTableVersion = 2;
+
+struct SampleTableHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrderMark;    // 0x01020304 as written
+    std::uint32_t channelCount;
+    std::uint32_t reserved;
+    std::uint64_t frameCount;
+    std::int64_t startTime;
+    double frameRate;
+};
+
+// samples every channel of every table at every frame of its grid, on
+// `jobs` workers, and writes one row per frame and one column per channel.
+// In the CSV every table has its own header row, starting with a column of
+// the frame times in seconds, and tables are separated by an empty line.
+// The frames are sampled in blocks, so memory stays bounded on long takes.
+// Returns false if the file could not be written.
+bool writeSampleTables(std::string_view fileName, SampleFormat format, const std::vector<SampleTable>& tables, unsigned jobs);
+
+} // namespace fbxViz
@@ -0,0 +1,83 @@
+#include "curveSnapshot.h"
+
+#include <array>
+
+namespace {
+
+    constexpr std::array<std::string_view, 4> InterpolationNames = { "constant", "linear", "cubic", "?" };
+    constexpr std::array<std::string_view, 7> TangentModeNames = { "Auto", "AutoBreak", "TCB", "User", "GenericBreak", "Break", "?" };
+    constexpr std::array<std::string_view, 4> TangentWeightNames = { "None", "WeightedRight", "WeightedNextLeft", "WeightedAll" };
+    constexpr std::array<std::string_view, 2> ConstantModeNames = { "ConstantStandard", "ConstantNext" };
+
+} // namespace
+
+namespace fbxViz {
+
+std::string_view interpolationName(KeyInterpolation interpolation)
+{
+    return InterpolationNames[static_cast<std::size_t>(interpolation)];
+}
+
+std::string_view tangentModeName(KeyTangentMode mode)
+{
+    return TangentModeNames[static_cast<std::size_t>(mode)];
+}
+
+std::string_view tangentWeightName(KeyTangentWeight weight)
+{
+    return TangentWeightNames[static_cast<std::size_t>(weight)];
+}
+
+std::string_view constantModeName(KeyConstantMode mode)
+{
+    return ConstantModeNames[static_cast<std::size_t>(mode)];
+}
+
+void CurveSnapshot::reserve(std::size_t keyCount)
+{
+    times.reserve(keyCount);
+    values.reserve(keyCount);
+    leftDerivatives.reserve(keyCount);
+    rightDerivatives.reserve(keyCount);
+    flags.reserve(keyCount);
+}
+
+void CurveSnapshot::addKey(std::int64_t time, float value, float leftDerivative, float rightDerivative, std::uint8_t keyFlags)
+{
+    times.push_back(time);
+    values.push_back(value);
+    leftDerivatives.push_back(leftDerivative);
+    rightDerivatives.push_back(rightDerivative);
+    flags.push_back(keyFlags);
+}
+
+KeyInterpolation CurveSnapshot::interpolation(std::size_t key) const
+{
+    return static_cast<KeyInterpolation>(flags[key] & 0x3);
+}
+
+KeyTangentMode CurveSnapshot::tangentMode(std::size_t key) const
+{
+    return static_cast<KeyTangentMode>((flags[key] >> 2) & 0x7);
+}
+
+KeyTangentWeight CurveSnapshot::tangentWeight(std::size_t key) const
+{
+    return static_cast<KeyTangentWeight>((flags[key] >> 5) & 0x3);
+}
+
+KeyConstantMode CurveSnapshot::constantMode(std::size_t key) const
+{
+    return static_cast<KeyConstantMode>((flags[key] >> 7) & 0x1);
+}
+
+std::uint8_t CurveSnapshot::packFlags(KeyInterpolation interpolation, KeyTangentMode tangentMode,
+                                      KeyTangentWeight tangentWeight, KeyConstantMode constantMode)
+{
+    return static_cast<std::uint8_t>(static_cast<unsigned>(interpolation)
+                                     | (static_cast<unsigned>(tangentMode) << 2)
+                                     | (static_cast<unsigned>(tangentWeight) << 5)
+                                     | (static_cast<unsigned>(constantMode) << 7));
+}
+
+} // namespace fbxViz
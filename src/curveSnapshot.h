@@ -0,0 +1,97 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace fbxViz {
+
+enum class KeyInterpolation : std::uint8_t
+{
+    Constant,   // value stays the same until next key
+    Linear,     // straight line to the next key
+    Cubic,      // Bezier spline
+    Unknown
+};
+
+enum class KeyTangentMode : std::uint8_t
+{
+    Auto,           // spline cardinal
+    AutoBreak,
+    TCB,            // tension, continuity, bias
+    User,           // next slope at the left equal to slope at the right
+    GenericBreak,
+    Break,
+    Unknown
+};
+
+enum class KeyTangentWeight : std::uint8_t
+{
+    None,       // default weights of 0.333
+    Right,      // right tangent is weighted
+    NextLeft,   // left tangent is weighted
+    All         // both tangents are weighted
+};
+
+enum class KeyConstantMode : std::uint8_t
+{
+    Standard,   // value is constant between this key and the next
+    Next        // value is constant, with the next key's value
+};
+
+std::string_view interpolationName(KeyInterpolation interpolation);
+std::string_view tangentModeName(KeyTangentMode mode);
+std::string_view tangentWeightName(KeyTangentWeight weight);
+std::string_view constantModeName(KeyConstantMode mode);
+
+// the keys of one animation curve extracted once into contiguous arrays,
+// so labels, statistics and exports run tight loops instead of querying
+// the FBX SDK key by key. Times are FbxTime ticks.
+struct CurveSnapshot
+{
+    std::size_t keyCount() const { return times.size(); }
+
+    void reserve(std::size_t keyCount);
+    void addKey(std::int64_t time, float value, float leftDerivative, float rightDerivative, std::uint8_t keyFlags);
+
+    KeyInterpolation interpolation(std::size_t key) const;
+    KeyTangentMode tangentMode(std::size_t key) const;
+    KeyTangentWeight tangentWeight(std::size_t key) const;
+    KeyConstantMode constantMode(std::size_t key) const;
+
+    // flags byte: interpolation in bits 0-1, tangent mode in bits 2-4,
+    // tangent weight in bits 5-6 and the constant mode in bit 7
+    static std::uint8_t packFlags(KeyInterpolation interpolation, KeyTangentMode tangentMode,
+                                  KeyTangentWeight tangentWeight, KeyConstantMode constantMode);
+
+    std::vector<std::int64_t> times;
+    std::vector<float> values;
+    std::vector<float> leftDerivatives;
+    std::vector<float> rightDerivatives;
+    std::vector<std::uint8_t> flags;
+};
+
+} // namespace fbxViz
@@ -0,0 +1,87 @@
+#include "curveStats.h"
+
+#include <algorithm>
+
+namespace {
+
+    constexpr std::size_t Lanes = 8;
+
+    void reduceValues(const float* values, std::size_t count, float& minValue, float& maxValue, double& sum)
+    {
+        float mins[Lanes];
+        float maxs[Lanes];
+        double sums[Lanes];
+        for (std::size_t lane = 0; lane < Lanes; ++lane) {
+            mins[lane] = values[0];
+            maxs[lane] = values[0];
+            sums[lane] = 0.0;
+        }
+
+        // independent lanes, no loop carried dependency between them
+        std::size_t i = 0;
+        for (; i + Lanes <= count; i += Lanes) {
+            for (std::size_t lane = 0; lane < Lanes; ++lane) {
+                const auto value = values[i + lane];
+                mins[lane] = value < mins[lane] ? value : mins[lane];
+                maxs[lane] = value > maxs[lane] ? value : maxs[lane];
+                sums[lane] += value;
+            }
+        }
+        for (; i < count; ++i) {
+            mins[0] = std::min(mins[0], values[i]);
+            maxs[0] = std::max(maxs[0], values[i]);
+            sums[0] += values[i];
+        }
+
+        minValue = *std::min_element(mins, mins + Lanes);
+        maxValue = *std::max_element(maxs, maxs + Lanes);
+        sum = 0.0;
+        for (std::size_t lane = 0; lane < Lanes; ++lane) {
+            sum += sums[lane];
+        }
+    }
+
+    // branch free histogram of the interpolation bits of the flag bytes
+    void countInterpolations(const std::uint8_t* flags, std::size_t count, std::array<std::size_t, 4>& counts)
+    {
+        std::size_t constant = 0, linear = 0, cubic = 0;
+        for (std::size_t i = 0; i < count; ++i) {
+            const unsigned interpolation = flags[i] & 0x3u;
+            constant += interpolation == 0;
+            linear += interpolation == 1;
+            cubic += interpolation == 2;
+        }
+
+        counts[0] = constant;
+        counts[1] = linear;
+        counts[2] = cubic;
+        counts[3] = count - constant - linear - cubic;
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+CurveStats computeCurveStats(const CurveSnapshot& snapshot)
+{
+    CurveStats stats;
+
+    stats.keyCount = snapshot.keyCount();
+    if (stats.keyCount == 0) {
+        return stats;
+    }
+
+    // keys are sorted by time
+    stats.startTime = snapshot.times.front();
+    stats.stopTime = snapshot.times.back();
+
+    double sum = 0.0;
+    reduceValues(snapshot.values.data(), stats.keyCount, stats.minValue, stats.maxValue, sum);
+    stats.meanValue = sum / static_cast<double>(stats.keyCount);
+
+    countInterpolations(snapshot.flags.data(), stats.keyCount, stats.interpolationCounts);
+
+    return stats;
+}
+
+} // namespace fbxViz
@@ -0,0 +1,95 @@
+#include "flatScene.h"
+#include "nodeType.h"
+
+#include <cassert>
+#include <iterator>
+#include <string>
+
+namespace fbxViz {
+
+FlatScene::FlatScene(FbxScene* pScene)
+    : m_scene(pScene)
+    , m_typeNames(std::begin(NodeTypeNames), std::end(NodeTypeNames))
+{
+    FbxNode* rootNode = pScene->GetRootNode();
+    if (!rootNode) {
+        return;
+    }
+
+    struct Pending
+    {
+        FbxNode* node;
+        Index parent;
+    };
+
+    std::string typeName;
+
+    // children come off the stack in order, the last one so far gets the
+    // next as its sibling
+    std::vector<Index> lastChildren;
+
+    std::vector<Pending> stack{ { rootNode, None } };
+    while (!stack.empty()) {
+        const auto pending = stack.back();
+        stack.pop_back();
+
+        FbxNode* pNode = pending.node;
+        const auto index = static_cast<Index>(m_nodes.size());
+
+        if (pending.parent != None) {
+            if (m_firstChildren[pending.parent] == None) {
+                m_firstChildren[pending.parent] = index;
+            } else {
+                m_nextSiblings[lastChildren[pending.parent]] = index;
+            }
+            lastChildren[pending.parent] = index;
+        }
+
+        std::uint32_t typeMask = 0;
+        std::uint16_t typeId = 0;
+        const auto attributeCount = pNode->GetNodeAttributeCount();
+        if (attributeCount == 1) {
+            const auto type = pNode->GetNodeAttributeByIndex(0)->GetAttributeType();
+            typeMask = std::uint32_t(1) << type;
+            typeId = static_cast<std::uint16_t>(nodeType(type));
+        } else {
+            typeName.clear();
+            for (auto i = 0; i < attributeCount; ++i) {
+                const auto type = pNode->GetNodeAttributeByIndex(i)->GetAttributeType();
+                typeMask |= std::uint32_t(1) << type;
+                typeName += nodeTypeName(nodeType(type));
+            }
+            typeId = internTypeName(typeName);
+        }
+
+        m_nodes.push_back(pNode);
+        m_uniqueIds.push_back(pNode->GetUniqueID());
+        m_parents.push_back(pending.parent);
+        m_firstChildren.push_back(None);
+        m_nextSiblings.push_back(None);
+        m_names.push_back(m_strings.intern(pNode->GetName()));
+        m_typeIds.push_back(typeId);
+        m_typeMasks.push_back(typeMask);
+        lastChildren.push_back(None);
+
+        // reversed so the children come off the stack in order
+        for (auto i = pNode->GetChildCount(); i-- > 0;) {
+            stack.push_back({ pNode->GetChild(i), index });
+        }
+    }
+}
+
+std::uint16_t FlatScene::internTypeName(std::string_view typeName)
+{
+    for (std::size_t i = 0; i < m_typeNames.size(); ++i) {
+        if (m_typeNames[i] == typeName) {
+            return static_cast<std::uint16_t>(i);
+        }
+    }
+
+    assert(m_typeNames.size() < 0xffff);
+    m_typeNames.push_back(m_strings.intern(typeName));
+    return static_cast<std::uint16_t>(m_typeNames.size() - 1);
+}
+
+} // namespace fbxViz
@@ -0,0 +1,131 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "graph/stringPool.h"
+
+#include <fbxsdk.h>
+
+#include <cstdint>
+#include <string_view>
+#include <vector>
+
+namespace fbxViz {
+
+// the node hierarchy of a scene flattened once into contiguous arrays in
+// pre-order, so the dumps and analyses walk indices instead of the SDK
+// pointer graph and never query names or attributes twice. Index 0 is the
+// scene root, the subtree of a node is the range of indices that follow it.
+class FlatScene final
+{
+public:
+    using Index = std::uint32_t;
+    static constexpr Index None = ~Index(0);
+
+    // walks the hierarchy iteratively, deep scenes do not grow the stack
+    explicit FlatScene(FbxScene* pScene);
+
+    // delete copy and move, the name views point into the pool
+    FlatScene(const FlatScene& other) = delete;
+    FlatScene& operator=(const FlatScene& other) = delete;
+    FlatScene(FlatScene&& other) = delete;
+    FlatScene& operator=(FlatScene&& other) = delete;
+
+    FbxScene* scene() const { return m_scene; }
+    std::size_t size() const { return m_nodes.size(); }
+    bool empty() const { return m_nodes.empty(); }
+
+    FbxNode* node(Index i) const { return m_nodes[i]; }
+    std::uint64_t uniqueId(Index i) const { return m_uniqueIds[i]; }
+
+    Index parent(Index i) const { return m_parents[i]; }
+    Index firstChild(Index i) const { return m_firstChildren[i]; }
+    Index nextSibling(Index i) const { return m_nextSiblings[i]; }
+
+    std::string_view name(Index i) const { return m_names[i]; }
+
+    // the attribute labels of the node joined, e.g. "mesh" or "" for the root
+    std::string_view typeName(Index i) const { return m_typeNames[m_typeIds[i]]; }
+
+    // one bit per FbxNodeAttribute::EType of the node
+    std::uint32_t typeMask(Index i) const { return m_typeMasks[i]; }
+
+    // calls visit(index, depth) for root and its subtree in pre-order, depth
+    // counted from root. The children of a node are skipped when visit
+    // returns false. Iterative, through the parent and sibling links.
+    template <typename Visit>
+    void walk(Index root, Visit&& visit) const;
+
+private:
+    std::uint16_t internTypeName(std::string_view typeName);
+
+    FbxScene* m_scene;
+
+    std::vector<FbxNode*> m_nodes;
+    std::vector<std::uint64_t> m_uniqueIds;
+    std::vector<Index> m_parents;
+    std::vector<Index> m_firstChildren;
+    std::vector<Index> m_nextSiblings;
+    std::vector<std::string_view> m_names;
+    std::vector<std::uint16_t> m_typeIds;
+    std::vector<std::uint32_t> m_typeMasks;
+
+    // the first type labels are the NodeType names, so a node with a single
+    // attribute has its NodeType as id. Other labels follow as they are seen.
+    std::vector<std::string_view> m_typeNames;
+
+    // names and joined type labels
+    StringPool m_strings;
+};
+
+template <typename Visit>
+void FlatScene::walk(Index root, Visit&& visit) const
+{
+    if (root == None) {
+        return;
+    }
+
+    Index i = root;
+    unsigned depth = 0;
+    while (true) {
+        if (visit(i, depth) && m_firstChildren[i] != None) {
+            i = m_firstChildren[i];
+            ++depth;
+            continue;
+        }
+
+        // up to the closest ancestor with a next sibling, staying below root
+        while (i != root && m_nextSiblings[i] == None) {
+            i = m_parents[i];
+            --depth;
+        }
+
+        if (i == root) {
+            return;
+        }
+        i = m_nextSiblings[i];
+    }
+}
+
+} // namespace fbxViz
@@ -0,0 +1,231 @@
+#include "compression.h"
+
+#include <fmt/core.h>
+
+#if defined(FBXVIZ_WITH_ZLIB)
+#include <zlib.h>
+#endif
+
+#if defined(FBXVIZ_WITH_ZSTD)
+#include <zstd.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+namespace {
+
+    bool endsWith(std::string_view str, std::string_view suffix)
+    {
+        return str.size() >= suffix.size() && str.compare(str.size() - suffix.size(), suffix.size(), suffix) == 0;
+    }
+
+    // compressed bytes are staged here before going to the file
+    constexpr std::size_t ChunkSize = 256 * 1024;
+
+#if defined(FBXVIZ_WITH_ZLIB)
+    class GzipCompressor final : public fbxViz::Compressor
+    {
+    public:
+        GzipCompressor()
+            : m_chunk(ChunkSize)
+        {
+            // the fastest level: the graphs are repetitive text that still
+            // shrinks several times and the compressor has to keep up with
+            // the formatting. 15 + 16 is the largest window with a gzip
+            // header and trailer.
+            m_valid = deflateInit2(&m_stream, Z_BEST_SPEED, Z_DEFLATED, 15 + 16, 8, Z_DEFAULT_STRATEGY) == Z_OK;
+            if (!m_valid) {
+                fmt::print("Error: unable to initialize the gzip compressor!\n");
+            }
+        }
+
+        ~GzipCompressor() override
+        {
+            if (m_valid) {
+                deflateEnd(&m_stream);
+            }
+        }
+
+        std::size_t write(std::string_view data, std::FILE* file) override
+        {
+            return deflateAll(data, Z_NO_FLUSH, file);
+        }
+
+        std::size_t finish(std::FILE* file) override
+        {
+            return deflateAll({}, Z_FINISH, file);
+        }
+
+    private:
+        std::size_t deflateAll(std::string_view data, int flush, std::FILE* file)
+        {
+            if (!m_valid) {
+                return 0;
+            }
+
+            // uInt is 32 bits, feed larger buffers in pieces
+            constexpr std::size_t MaxInput = 1u << 30;
+
+            std::size_t written = 0;
+            do {
+                const auto size = std::min(data.size(), MaxInput);
+                const auto pieceFlush = size == data.size() ? flush : Z_NO_FLUSH;
+                m_stream.next_in = reinterpret_cast<Bytef*>(const_cast<char*>(data.data()));
+                m_stream.avail_in = static_cast<uInt>(size);
+
+                // a full output chunk means deflate has more to give
+                do {
+                    m_stream.next_out = reinterpret_cast<Bytef*>(m_chunk.data());
+                    m_stream.avail_out = static_cast<uInt>(m_chunk.size());
+                    deflate(&m_stream, pieceFlush);
+                    written += std::fwrite(m_chunk.data(), 1, m_chunk.size() - m_stream.avail_out, file);
+                } while (m_stream.avail_out == 0);
+
+                data.remove_prefix(size);
+            } while (!data.empty());
+
+            return written;
+        }
+
+        z_stream m_stream{};
+        std::vector<char> m_chunk;
+        bool m_valid{false};
+    };
+#endif
+
+#if defined(FBXVIZ_WITH_ZSTD)
+    class ZstdCompressor final : public fbxViz::Compressor
+    {
+    public:
+        ZstdCompressor()
+            : m_context(ZSTD_createCCtx())
+            , m_chunk(ChunkSize)
+        {
+            if (!m_context) {
+                fmt::print("Error: unable to initialize the zstd compressor!\n");
+                return;
+            }
+
+            ZSTD_CCtx_setParameter(m_context, ZSTD_c_compressionLevel, ZSTD_CLEVEL_DEFAULT);
+        }
+
+        ~ZstdCompressor() override
+        {
+            ZSTD_freeCCtx(m_context);
+        }
+
+        std::size_t write(std::string_view data, std::FILE* file) override
+        {
+            return compress(data, ZSTD_e_continue, file);
+        }
+
+        std::size_t finish(std::FILE* file) override
+        {
+            return compress({}, ZSTD_e_end, file);
+        }
+
+    private:
+        std::size_t compress(std::string_view data, ZSTD_EndDirective directive, std::FILE* file)
+        {
+            if (!m_context) {
+                return 0;
+            }
+
+            std::size_t written = 0;
+            ZSTD_inBuffer input{ data.data(), data.size(), 0 };
+            for (;;) {
+                ZSTD_outBuffer output{ m_chunk.data(), m_chunk.size(), 0 };
+                const auto remaining = ZSTD_compressStream2(m_context, &output, &input, directive);
+                if (ZSTD_isError(remaining)) {
+                    fmt::print("Error: zstd compression failed, {}!\n", ZSTD_getErrorName(remaining));
+                    return written;
+                }
+
+                written += std::fwrite(m_chunk.data(), 1, output.pos, file);
+
+                // continue is done once the input is consumed, end once
+                // nothing is left in the context either
+                const bool done = directive == ZSTD_e_end ? remaining == 0 : input.pos == input.size;
+                if (done) {
+                    return written;
+                }
+            }
+        }
+
+        ZSTD_CCtx* m_context;
+        std::vector<char> m_chunk;
+    };
+#endif
+
+} // namespace
+
+namespace fbxViz {
+
+std::string_view compressionExtension(Compression compression)
+{
+    switch (compression) {
+        case Compression::None: return {};
+        case Compression::Gzip: return ".gz";
+        case Compression::Zstd: return ".zst";
+    }
+
+    return {};
+}
+
+Compression compressionFromFileName(std::string_view fileName)
+{
+    for (const auto compression : { Compression::Gzip, Compression::Zstd }) {
+        if (endsWith(fileName, compressionExtension(compression))) {
+            return compression;
+        }
+    }
+
+    return Compression::None;
+}
+
+bool isCompressionAvailable(Compression compression)
+{
+    switch (compression) {
+        case Compression::None:
+            return true;
+        case Compression::Gzip:
+#if defined(FBXVIZ_WITH_ZLIB)
+            return true;
+#else
+            return false;
+#endif
+        case Compression::Zstd:
+#if defined(FBXVIZ_WITH_ZSTD)
+            return true;
+#else
+            return false;
+#endif
+    }
+
+    return false;
+}
+
+std::unique_ptr<Compressor> Compressor::create(Compression compression)
+{
+    switch (compression) {
+        case Compression::None:
+            return nullptr;
+        case Compression::Gzip:
+#if defined(FBXVIZ_WITH_ZLIB)
+            return std::make_unique<GzipCompressor>();
+#else
+            return nullptr;
+#endif
+        case Compression::Zstd:
+#if defined(FBXVIZ_WITH_ZSTD)
+            return std::make_unique<ZstdCompressor>();
+#else
+            return nullptr;
+#endif
+    }
+
+    return nullptr;
+}
+
+} // namespace fbxViz
@@ -0,0 +1,73 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstdio>
+#include <memory>
+#include <string_view>
+
+namespace fbxViz {
+
+// --compress, or the extension of an output file name
+enum class Compression
+{
+    None,
+    Gzip,       // zlib deflate with a gzip header, any gunzip reads it
+    Zstd
+};
+
+// ".gz", ".zst" or an empty string
+std::string_view compressionExtension(Compression compression);
+
+// the compression a file name asks for by its extension
+Compression compressionFromFileName(std::string_view fileName);
+
+// gzip and zstd are only there when FbxViz was built with zlib and libzstd
+bool isCompressionAvailable(Compression compression);
+
+// streaming compressor used by OutputBuffer. Every call compresses as much
+// input as it is given and appends the compressed bytes to the file.
+class Compressor
+{
+public:
+    // nullptr when the compression is None or was not built in
+    static std::unique_ptr<Compressor> create(Compression compression);
+
+    Compressor() = default;
+    virtual ~Compressor() = default;
+
+    // delete copy and move
+    Compressor(const Compressor& other) = delete;
+    Compressor& operator=(const Compressor& other) = delete;
+    Compressor(Compressor&& other) = delete;
+    Compressor& operator=(Compressor&& other) = delete;
+
+    // both return the compressed bytes written to the file
+    virtual std::size_t write(std::string_view data, std::FILE* file) = 0;
+
+    // flushes the internal state and ends the stream
+    virtual std::size_t finish(std::FILE* file) = 0;
+};
+
+} // namespace fbxViz
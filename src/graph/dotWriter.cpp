@@ -0,0 +1,140 @@
+#include "dotWriter.h"
+#include "nodeData.h"
+
+namespace {
+
+    // text inside an HTML label
+    void writeHtml(fbxViz::OutputBuffer& out, std::string_view text)
+    {
+        std::size_t pos = 0;
+        for (auto special = text.find_first_of("&<>"); special != std::string_view::npos; special = text.find_first_of("&<>", pos)) {
+            out.write(text.substr(pos, special - pos));
+            out.write(text[special] == '&' ? "&amp;" : text[special] == '<' ? "&lt;" : "&gt;");
+            pos = special + 1;
+        }
+        out.write(text.substr(pos));
+    }
+
+    // node names are sanitized the same way DGraph does it, streamed nodes
+    // are not stored so it happens here
+    void writeName(fbxViz::OutputBuffer& out, std::string_view name)
+    {
+        std::size_t pos = 0;
+        for (auto space = name.find(' '); space != std::string_view::npos; space = name.find(' ', pos)) {
+            writeHtml(out, name.substr(pos, space - pos));
+            out.put('_');
+            pos = space + 1;
+        }
+        writeHtml(out, name.substr(pos));
+    }
+
+    // one table row per data row, "name= value , name= value"
+    void writeDataRows(fbxViz::OutputBuffer& out, std::string_view data)
+    {
+        fbxViz::NodeDataCursor cursor(data);
+        fbxViz::NodeDataField field;
+        while (cursor.nextRow()) {
+            out.write("<tr><td align='left'>");
+
+            std::string_view separator;
+            while (cursor.nextField(field)) {
+                out.write(separator);
+                separator = " , ";
+
+                if (field.name.empty()) {
+                    writeHtml(out, field.value);
+                    continue;
+                }
+
+                writeHtml(out, field.name);
+                out.write("= <font color='red'><b>");
+                writeHtml(out, field.value);
+                out.write("</b></font>");
+            }
+
+            out.write("</td></tr>\n");
+        }
+    }
+
+    // the type of a diff node is the change it shows
+    std::string_view diffFillColor(std::string_view change)
+    {
+        if (change == "added") {
+            return "#90ee90";
+        } else if (change == "removed") {
+            return "#f08080";
+        } else if (change == "modified") {
+            return "#ffd700";
+        }
+
+        return "#d3d3d3";
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+DotWriter::DotWriter(std::string_view fileName, std::size_t bufferSize, DotStyle style)
+    : GraphWriter(fileName, bufferSize)
+    , m_style(style)
+{
+}
+
+void DotWriter::writeHeader(std::string_view graphName)
+{
+    m_out.format("digraph {} {{\n\n", graphName);
+}
+
+void DotWriter::writeNode(NodeId id, const Node& node)
+{
+    std::string_view shape = "box";
+
+    if (m_style == DotStyle::Dag) {
+        shape = "ellipse";
+
+        // special case ( root )
+        if (node.getType().empty()){
+            shape = "box";
+        } else if(node.getType() == "mesh") {
+            shape = "diamond";
+        }
+    }
+
+    // the ID is the node id, distinct FBX objects sharing a name stay
+    // distinct nodes. The name is only shown in the label.
+    m_out.format("n{} [\n"
+                 "  label = <\n"
+                 "  <table border='0' cellborder='0' cellspacing='1'>\n"
+                 "  <tr><td align=\"center\"><b>",
+                 id);
+    writeName(m_out, node.getName());
+    m_out.format("</b></td></tr>\n"
+                 "  <tr><td align=\"center\">({})</td></tr>\n",
+                 node.getType());
+
+    writeDataRows(m_out, node.getDataInfo());
+
+    std::string_view fillColor = m_style == DotStyle::Diff ? diffFillColor(node.getType()) : "#40e0d0";
+    if (!node.getFillColor().empty()) {
+        fillColor = node.getFillColor();
+    }
+
+    m_out.format("  </table>> \n"
+                 "  shape = {}\n"
+                 "  fillcolor = \"{}\"\n"
+                 "  style=\"filled\"\n"
+                 "]\n\n",
+                 shape, fillColor);
+}
+
+void DotWriter::writeEdge(const NodeRef& src, const NodeRef& dest)
+{
+    m_out.format("n{} -> n{};\n", src.id, dest.id);
+}
+
+void DotWriter::writeFooter()
+{
+    m_out.write("\n}\n");
+}
+
+} // namespace fbxViz
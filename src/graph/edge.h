@@ -27,31 +27,26 @@
 
 namespace fbxViz {
 
+// directed edge between two nodes of the same graph, stored by index so
+// edges stay trivially copyable no matter how much data a node carries.
 class Edge final
 {
 public:
     Edge() = default;
-    Edge(const Node& src, const Node& dest);
-    virtual ~Edge() = default;
+    Edge(NodeId src, NodeId dest);
+    ~Edge() = default;
 
     Edge(const Edge& other) = default;
     Edge& operator=(const Edge& other) = default;
     Edge(Edge&& other) = default;
     Edge& operator=(Edge&& other) = default;
 
-    const Node& src() const;
-    const Node& dest()const;
-    const int edgeId() const;
-
-    void setName(std::string_view edgeName);
-    const std::string& getName() const;
+    NodeId src() const;
+    NodeId dest() const;
 
 private:
-    Node m_src;
-    Node m_dest;
-
-    int m_edgeId;
-    std::string m_name;
+    NodeId m_src{InvalidNodeId};
+    NodeId m_dest{InvalidNodeId};
 };
 
 } // namespace fbxViz
@@ -0,0 +1,55 @@
+#include "edgeListWriter.h"
+
+#include <algorithm>
+#include <iterator>
+#include <type_traits>
+
+namespace fbxViz {
+
+template <typename T>
+void EdgeListWriter::writeValue(const T& value)
+{
+    static_assert(std::is_trivially_copyable<T>::value, "records are written byte wise");
+    m_out.write(std::string_view(reinterpret_cast<const char*>(&value), sizeof(T)));
+}
+
+void EdgeListWriter::writeString(std::string_view str)
+{
+    writeValue(static_cast<std::uint32_t>(str.size()));
+    m_out.write(str);
+}
+
+EdgeListWriter::EdgeListWriter(std::string_view fileName, std::size_t bufferSize)
+    : GraphWriter(fileName, bufferSize)
+{
+}
+
+void EdgeListWriter::writeHeader(std::string_view)
+{
+    EdgeListHeader header{};
+    std::copy(std::begin(EdgeListMagic), std::end(EdgeListMagic), header.magic);
+    header.version = EdgeListVersion;
+    header.byteOrderMark = 0x01020304;
+    writeValue(header);
+}
+
+void EdgeListWriter::writeNode(NodeId id, const Node& node)
+{
+    writeValue(EdgeListRecord::Node);
+    writeValue(static_cast<std::uint32_t>(id));
+    writeString(node.getName());
+    writeString(node.getType());
+}
+
+void EdgeListWriter::writeEdge(const NodeRef& src, const NodeRef& dest)
+{
+    writeValue(EdgeListRecord::Edge);
+    writeValue(static_cast<std::uint32_t>(src.id));
+    writeValue(static_cast<std::uint32_t>(dest.id));
+}
+
+void EdgeListWriter::writeFooter()
+{
+}
+
+} // namespace fbxViz
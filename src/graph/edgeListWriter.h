@@ -0,0 +1,75 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "graphWriter.h"
+
+#include <cstdint>
+#include <string_view>
+
+namespace fbxViz {
+
+// compact binary edge list for tools that only want the structure. After
+// the header the file is a sequence of records, all integers in the byte
+// order of the writer:
+//   node: uint8 EdgeListRecord::Node, uint32 id, uint32 name size, name,
+//         uint32 type size, type
+//   edge: uint8 EdgeListRecord::Edge, uint32 src id, uint32 dest id
+// A node record always comes before the edges that use its id. Data rows are
+// not written.
+constexpr char EdgeListMagic[8] = { 'F', 'B', 'X', 'V', 'I', 'Z', 'E', '\0' };
+constexpr std::uint32_t EdgeListVersion = 1;
+
+struct EdgeListHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrderMark;    // 0x01020304 as written
+};
+
+enum class EdgeListRecord : std::uint8_t
+{
+    Node = 0,
+    Edge = 1
+};
+
+class EdgeListWriter final : public GraphWriter
+{
+public:
+    EdgeListWriter(std::string_view fileName, std::size_t bufferSize);
+
+    void writeHeader(std::string_view graphName) override;
+    void writeNode(NodeId id, const Node& node) override;
+    void writeEdge(const NodeRef& src, const NodeRef& dest) override;
+
+protected:
+    void writeFooter() override;
+
+private:
+    template <typename T>
+    void writeValue(const T& value);
+    void writeString(std::string_view str);
+};
+
+} // namespace fbxViz
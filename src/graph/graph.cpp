@@ -1,8 +1,11 @@
 #include "graph.h"
+#include "graphSnapshot.h"
+#include "svgWriter.h"
+#include "treeLayout.h"
 
-#include <fmt/core.h>
-
-#include <fstream>
+#include <algorithm>
+#include <cassert>
+#include <ostream>
 
 namespace fbxViz {
 
@@ -11,83 +14,103 @@ DGraph::DGraph(std::string_view name)
 {
 }
 
-void DGraph::dumpDag(std::string_view fileName) 
+void DGraph::dumpDag(std::string_view fileName, GraphFormat format)
 {
-    std::ofstream out(fileName.data());
+    dumpGraph(fileName, format, DotStyle::Dag);
+}
 
-    out << "digraph " << graphName << " {\n\n";
-    
-    out << "# Nodes" << "\n"; 
-    for (const auto& node : m_nodes) {
+void DGraph::dumpAnimStack(std::string_view fileName, GraphFormat format)
+{
+    dumpGraph(fileName, format, DotStyle::AnimStack);
+}
 
-        std::string_view shape = "ellipse";
+void DGraph::dumpDiff(std::string_view fileName, GraphFormat format)
+{
+    dumpGraph(fileName, format, DotStyle::Diff);
+}
 
-        // special case ( root )
-        if (node.getType().empty()){
-            shape = "box";   
-        } else if(node.getType() == "mesh") {
-            shape = "diamond";   
-        }
+void DGraph::dumpSnapshot(std::string_view fileName, const std::vector<SnapshotCurve>& curves)
+{
+    freeze();
+    writeGraphSnapshot(*this, curves, fileName);
+}
 
-        out << node.getName() << " [" << '\n'
-            << "  label = " << "<" << '\n'
-            << "  <table border='0' cellborder='0' cellspacing='1'>" << '\n'
-            << "  <tr><td align=\"center\"><b>" << node.getName() << "</b></td></tr>" << '\n'
-            << "  <tr><td align=\"center\">" << "(" << node.getType() << ")"<< "</td></tr>" << '\n'
-            << "  </table>> " << '\n'
-            << "  shape = " << shape << '\n'
-            << "  fillcolor = \"#40e0d0\"" << '\n'
-            << "  style=\"filled\"" << '\n'
-            << "]\n\n";
+void DGraph::dumpSvg(std::string_view fileName)
+{
+    freeze();
+    writeSvg(*this, computeTreeLayout(*this), fileName);
+}
+
+void DGraph::dumpGraph(std::string_view fileName, GraphFormat format, DotStyle style)
+{
+    freeze();
+
+    auto writer = createGraphWriter(format, style, fileName);
+    if (!writer) {
+        return;
     }
 
-    out << "# Edges" << "\n";
-    for (const Edge& edge : m_edges) {
-        out << edge << ";\n";
+    writer->writeHeader(graphName);
+
+    for (NodeId id = 0; id < m_nodes.size(); ++id) {
+        writer->writeNode(id, m_nodes[id]);
     }
 
-    out << "\n}\n";
+    for (NodeId src = 0; src < m_nodes.size(); ++src) {
+        const NodeRef srcRef{ src, m_nodes[src].getName() };
+        for (NodeId dest : children(src)) {
+            writer->writeEdge(srcRef, { dest, m_nodes[dest].getName() });
+        }
+    }
 
-    fmt::print("Generated graph to {} successfully!!!\n", fileName);
+    writer->close();
 }
 
-void DGraph::dumpAnimStack(std::string_view fileName)
+NodeId DGraph::addNode(const NodeKey& key, const Node& node)
 {
-    std::ofstream out(fileName.data());
-
-    out << "digraph " << graphName << " {\n\n";
-    
-    out << "# Nodes" << "\n"; 
-    for (const auto& node : m_nodes) {
+    auto [it, inserted] = m_nodeIndex.try_emplace(key, static_cast<NodeId>(m_nodes.size()));
+    if (inserted) {
+        Node& pooled = m_nodes.emplace_back(internName(node.getName()));
+        pooled.setType(m_strings.intern(node.getType()));
+        pooled.setDataInfo(m_strings.store(node.getDataInfo()));
+        pooled.setFillColor(m_strings.intern(node.getFillColor()));
+        m_keys.emplace_back(key);
+        m_childOffsets.clear();
+    }
 
-        std::string_view shape = "box";
+    return it->second;
+}
 
-        out << node.getName() << " [" << '\n'
-            << "  label = " << "<" << '\n'
-            << "  <table border='0' cellborder='0' cellspacing='1'>" << '\n'
-            << "  <tr><td align=\"center\"><b>" << node.getName() << "</b></td></tr>" << '\n'
-            << "  <tr><td align=\"center\">" << "(" << node.getType() << ")"<< "</td></tr>" << '\n'
-            << node.getDataInfo()
-            << "  </table>> " << '\n'
-            << "  shape = " << shape << '\n'
-            << "  fillcolor = \"#40e0d0\"" << '\n'
-            << "  style=\"filled\"" << '\n'
-            << "]\n\n";
+std::string_view DGraph::internName(std::string_view name)
+{
+    if (name.find(' ') == std::string_view::npos) {
+        return m_strings.intern(name);
     }
 
-    out << "# Edges" << "\n";
-    for (const Edge& edge : m_edges) {
-        out << edge << ";\n";
-    }
+    m_nameBuffer.assign(name);
+    std::replace(m_nameBuffer.begin(), m_nameBuffer.end(), ' ', '_');
+    return m_strings.intern(m_nameBuffer);
+}
+
+NodeId DGraph::findNode(const NodeKey& key) const
+{
+    auto it = m_nodeIndex.find(key);
+    return it != m_nodeIndex.end() ? it->second : InvalidNodeId;
+}
 
-    out << "\n}\n";
+const Node& DGraph::getNode(NodeId id) const
+{
+    return m_nodes[id];
+}
 
-    fmt::print("Generated graph to {} successfully!!!\n", fileName);
+void DGraph::setDataInfo(NodeId id, std::string_view info)
+{
+    m_nodes[id].setDataInfo(m_strings.store(info));
 }
 
-void DGraph::addNode(const Node& node)
+const NodeKey& DGraph::getKey(NodeId id) const
 {
-    m_nodes.emplace_back(node);
+    return m_keys[id];
 }
 
 const DGraph::Nodes& DGraph::getNodes() const
@@ -95,9 +118,20 @@ const DGraph::Nodes& DGraph::getNodes() const
     return m_nodes;
 }
 
-void DGraph::addEdge(const Edge& edge)
+void DGraph::addEdge(NodeId src, NodeId dest)
+{
+    assert(src < m_nodes.size() && dest < m_nodes.size());
+
+    const auto edgeKey = (static_cast<std::uint64_t>(src) << 32) | dest;
+    if (m_edgeIndex.insert(edgeKey).second) {
+        m_edges.emplace_back(src, dest);
+        m_childOffsets.clear();
+    }
+}
+
+void DGraph::addEdge(const NodeRef& src, const NodeRef& dest)
 {
-    m_edges.emplace_back(edge);
+    addEdge(src.id, dest.id);
 }
 
 const DGraph::Edges& DGraph::getEdges() const
@@ -105,15 +139,85 @@ const DGraph::Edges& DGraph::getEdges() const
     return m_edges;
 }
 
-std::ostream& operator<<(std::ostream& out, const Node& node)
+void DGraph::merge(DGraph& other)
 {
-    out << node.getName();
-    return out;
+    // the nodes of other keep pointing into its blocks
+    m_strings.splice(other.m_strings);
+
+    std::vector<NodeId> remap(other.m_nodes.size());
+
+    for (NodeId id = 0; id < other.m_nodes.size(); ++id) {
+        const auto& key = other.m_keys[id];
+
+        auto [it, inserted] = m_nodeIndex.try_emplace(key, static_cast<NodeId>(m_nodes.size()));
+        if (inserted) {
+            m_nodes.emplace_back(std::move(other.m_nodes[id]));
+            m_keys.emplace_back(key);
+            m_childOffsets.clear();
+        }
+
+        remap[id] = it->second;
+    }
+
+    for (const Edge& edge : other.m_edges) {
+        addEdge(remap[edge.src()], remap[edge.dest()]);
+    }
+
+    other.clear();
 }
 
-std::ostream& operator<<(std::ostream& out, const Edge& edge) 
+void DGraph::clear()
 {
-    out << edge.src() << " -> " << edge.dest();
+    m_nodes.clear();
+    m_edges.clear();
+    m_keys.clear();
+    m_nodeIndex.clear();
+    m_edgeIndex.clear();
+    m_childOffsets.clear();
+    m_children.clear();
+    m_strings.clear();
+}
+
+void DGraph::freeze()
+{
+    if (isFrozen()) {
+        return;
+    }
+
+    // counting sort of the edges by source, stable so children keep their
+    // insertion order
+    m_childOffsets.assign(m_nodes.size() + 1, 0);
+    for (const Edge& edge : m_edges) {
+        ++m_childOffsets[edge.src() + 1];
+    }
+    for (std::size_t i = 1; i < m_childOffsets.size(); ++i) {
+        m_childOffsets[i] += m_childOffsets[i - 1];
+    }
+
+    std::vector<std::uint32_t> cursor(m_childOffsets.begin(), m_childOffsets.end() - 1);
+    m_children.resize(m_edges.size());
+    for (const Edge& edge : m_edges) {
+        m_children[cursor[edge.src()]++] = edge.dest();
+    }
+}
+
+bool DGraph::isFrozen() const
+{
+    return !m_childOffsets.empty();
+}
+
+NodeRange DGraph::children(NodeId id) const
+{
+    assert(isFrozen() && id < m_nodes.size());
+
+    const NodeId* first = m_children.data() + m_childOffsets[id];
+    const NodeId* last = m_children.data() + m_childOffsets[id + 1];
+    return NodeRange(first, last);
+}
+
+std::ostream& operator<<(std::ostream& out, const Node& node)
+{
+    out << node.getName();
     return out;
 }
 
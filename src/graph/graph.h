@@ -25,13 +25,39 @@
 
 #include "node.h"
 #include "edge.h"
+#include "graphSink.h"
+#include "graphWriter.h"
+#include "stringPool.h"
 
+#include <cstdint>
+#include <string>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <string_view>
 
 namespace fbxViz {
 
-class DGraph final
+struct SnapshotCurve;
+
+// contiguous range of NodeIds, e.g. the children of a node
+class NodeRange final
+{
+public:
+    NodeRange(const NodeId* first, const NodeId* last)
+        : m_first(first), m_last(last) {}
+
+    const NodeId* begin() const { return m_first; }
+    const NodeId* end() const { return m_last; }
+    std::size_t size() const { return static_cast<std::size_t>(m_last - m_first); }
+    bool empty() const { return m_first == m_last; }
+
+private:
+    const NodeId* m_first;
+    const NodeId* m_last;
+};
+
+class DGraph final : public GraphSink
 {
 public:
     using Nodes = std::vector<Node>;
@@ -47,23 +73,70 @@ public:
     DGraph(DGraph&& other) = delete;
     DGraph& operator=(DGraph&& other) = delete;
 
-    void addNode(const Node& node);
+    // interns a node: the first node added for a key is stored, later adds
+    // with the same key return the existing NodeId. The strings of the node
+    // are copied into the string pool of the graph, names and types once.
+    NodeId addNode(const NodeKey& key, const Node& node) override;
+    NodeId findNode(const NodeKey& key) const override;
+
+    const Node& getNode(NodeId id) const;
+    void setDataInfo(NodeId id, std::string_view info);
+    const NodeKey& getKey(NodeId id) const;
     const Nodes& getNodes() const;
 
-    void addEdge(const Edge& edge);
+    // duplicated edges are ignored
+    void addEdge(NodeId src, NodeId dest);
+    void addEdge(const NodeRef& src, const NodeRef& dest) override;
     const Edges& getEdges() const;
 
-    void dumpDag(std::string_view fileName);
-    void dumpAnimStack(std::string_view fileName);
+    // builds the compressed sparse row adjacency once the graph is complete.
+    // Adding nodes or edges afterwards drops it again.
+    void freeze();
+    bool isFrozen() const;
+
+    // children of a node in insertion order, requires a frozen graph
+    NodeRange children(NodeId id) const;
+
+    // moves the nodes and edges of other into this graph, nodes are interned
+    // by key and keep the order of other. other is left empty.
+    void merge(DGraph& other);
+    void clear();
+
+    void dumpDag(std::string_view fileName, GraphFormat format = GraphFormat::Dot);
+    void dumpAnimStack(std::string_view fileName, GraphFormat format = GraphFormat::Dot);
+    void dumpDiff(std::string_view fileName, GraphFormat format = GraphFormat::Dot);
+
+    // binary, memory mappable form of the graph and the key arrays of its
+    // curve nodes, see graphSnapshot.h
+    void dumpSnapshot(std::string_view fileName, const std::vector<SnapshotCurve>& curves);
+
+    // draws the graph as a tidy tree straight to SVG, see treeLayout.h. Meant
+    // for hierarchies too large for the Graphviz layout.
+    void dumpSvg(std::string_view fileName);
 
     std::string_view graphName;
 
 private:
+    void dumpGraph(std::string_view fileName, GraphFormat format, DotStyle style);
+
+    // spaces in names are replaced with underscores, DOT IDs cannot hold them
+    std::string_view internName(std::string_view name);
+
     Nodes m_nodes;
     Edges m_edges;
+    std::vector<NodeKey> m_keys;
+
+    StringPool m_strings;
+    std::string m_nameBuffer;
+
+    std::unordered_map<NodeKey, NodeId, NodeKeyHash> m_nodeIndex;
+    std::unordered_set<std::uint64_t> m_edgeIndex;
+
+    // CSR adjacency: children of node n are m_children[m_childOffsets[n] .. m_childOffsets[n + 1]]
+    std::vector<std::uint32_t> m_childOffsets;
+    std::vector<NodeId> m_children;
 };
 
 std::ostream& operator<<(std::ostream& out, const Node& node);
-std::ostream& operator<<(std::ostream& out, const Edge& edge);
 
 } // namespace fbxViz
@@ -0,0 +1,96 @@
+#include "graphMlWriter.h"
+#include "nodeData.h"
+
+namespace {
+
+    void writeEscaped(fbxViz::OutputBuffer& out, std::string_view text)
+    {
+        std::size_t pos = 0;
+        for (auto special = text.find_first_of("&<>\""); special != std::string_view::npos; special = text.find_first_of("&<>\"", pos)) {
+            out.write(text.substr(pos, special - pos));
+            switch (text[special]) {
+                case '&': out.write("&amp;"); break;
+                case '<': out.write("&lt;"); break;
+                case '>': out.write("&gt;"); break;
+                default: out.write("&quot;"); break;
+            }
+            pos = special + 1;
+        }
+        out.write(text.substr(pos));
+    }
+
+    // one line per row, "name=value, name=value"
+    void writeData(fbxViz::OutputBuffer& out, std::string_view data)
+    {
+        fbxViz::NodeDataCursor cursor(data);
+        fbxViz::NodeDataField field;
+
+        std::string_view rowSeparator;
+        while (cursor.nextRow()) {
+            out.write(rowSeparator);
+            rowSeparator = "\n";
+
+            std::string_view fieldSeparator;
+            while (cursor.nextField(field)) {
+                out.write(fieldSeparator);
+                fieldSeparator = ", ";
+
+                if (!field.name.empty()) {
+                    writeEscaped(out, field.name);
+                    out.put('=');
+                }
+                writeEscaped(out, field.value);
+            }
+        }
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+GraphMlWriter::GraphMlWriter(std::string_view fileName, std::size_t bufferSize)
+    : GraphWriter(fileName, bufferSize)
+{
+}
+
+void GraphMlWriter::writeHeader(std::string_view graphName)
+{
+    m_out.write("<?xml version=\"1.0\" encoding=\"UTF-8\"?>\n"
+                "<graphml xmlns=\"http://graphml.graphdrawing.org/xmlns\">\n"
+                "  <key id=\"name\" for=\"node\" attr.name=\"name\" attr.type=\"string\"/>\n"
+                "  <key id=\"type\" for=\"node\" attr.name=\"type\" attr.type=\"string\"/>\n"
+                "  <key id=\"data\" for=\"node\" attr.name=\"data\" attr.type=\"string\"/>\n"
+                "  <graph id=\"");
+    writeEscaped(m_out, graphName);
+    m_out.write("\" edgedefault=\"directed\">\n");
+}
+
+void GraphMlWriter::writeNode(NodeId id, const Node& node)
+{
+    m_out.format("    <node id=\"n{}\"><data key=\"name\">", id);
+    writeEscaped(m_out, node.getName());
+    m_out.write("</data><data key=\"type\">");
+    writeEscaped(m_out, node.getType());
+    m_out.write("</data>");
+
+    if (!node.getDataInfo().empty()) {
+        m_out.write("<data key=\"data\">");
+        writeData(m_out, node.getDataInfo());
+        m_out.write("</data>");
+    }
+
+    m_out.write("</node>\n");
+}
+
+void GraphMlWriter::writeEdge(const NodeRef& src, const NodeRef& dest)
+{
+    m_out.format("    <edge source=\"n{}\" target=\"n{}\"/>\n", src.id, dest.id);
+}
+
+void GraphMlWriter::writeFooter()
+{
+    m_out.write("  </graph>\n"
+                "</graphml>\n");
+}
+
+} // namespace fbxViz
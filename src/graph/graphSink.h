@@ -0,0 +1,54 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "node.h"
+
+#include <string_view>
+
+namespace fbxViz {
+
+// handle of a node handed out while a graph is being built. Every format
+// refers to the nodes by id. Streaming sinks do not keep nodes around, so the
+// handle also carries the node name as a convenience for callers, e.g. to
+// name the curves below a stack. The name must outlive the uses of the handle.
+struct NodeRef
+{
+    NodeId id{InvalidNodeId};
+    std::string_view name;
+};
+
+// receives the nodes and edges of a scene while it is traversed. DGraph
+// collects them in memory, GraphStreamWriter writes them out as they arrive.
+class GraphSink
+{
+public:
+    virtual ~GraphSink() = default;
+
+    virtual NodeId findNode(const NodeKey& key) const = 0;
+    virtual NodeId addNode(const NodeKey& key, const Node& node) = 0;
+    virtual void addEdge(const NodeRef& src, const NodeRef& dest) = 0;
+};
+
+} // namespace fbxViz
@@ -0,0 +1,389 @@
+#include "graphSnapshot.h"
+#include "outputBuffer.h"
+
+#include <fmt/core.h>
+
+#include <algorithm>
+#include <cassert>
+#include <cstring>
+#include <string>
+#include <type_traits>
+#include <unordered_map>
+
+namespace {
+
+    constexpr char SnapshotMagic[8] = { 'F', 'B', 'X', 'V', 'I', 'Z', 'G', '\0' };
+    constexpr std::uint32_t ByteOrderMark = 0x01020304;
+
+    static_assert(std::is_trivially_copyable<fbxViz::SnapshotHeader>::value, "snapshot records are copied byte wise");
+    static_assert(sizeof(fbxViz::SnapshotHeader) == 136, "snapshot header layout changed");
+    static_assert(sizeof(fbxViz::SnapshotNode) == 72, "snapshot node layout changed");
+    static_assert(sizeof(fbxViz::SnapshotCurveRecord) == 24, "snapshot curve layout changed");
+
+    std::uint64_t align8(std::uint64_t offset)
+    {
+        return (offset + 7) & ~std::uint64_t(7);
+    }
+
+    // strings are stored once, data infos and types repeat a lot
+    class StringTable
+    {
+    public:
+        fbxViz::SnapshotString add(std::string_view str)
+        {
+            auto [it, inserted] = m_offsets.try_emplace(std::string(str), m_pool.size());
+            if (inserted) {
+                m_pool += str;
+            }
+            return { it->second, str.size() };
+        }
+
+        const std::string& data() const { return m_pool; }
+
+    private:
+        std::unordered_map<std::string, std::uint64_t> m_offsets;
+        std::string m_pool;
+    };
+
+    class SectionWriter
+    {
+    public:
+        explicit SectionWriter(fbxViz::OutputBuffer& out)
+            : m_out(out) {}
+
+        template <typename T>
+        void write(const T* data, std::size_t count)
+        {
+            if (count > 0) {
+                m_out.write(std::string_view(reinterpret_cast<const char*>(data), count * sizeof(T)));
+                m_offset += count * sizeof(T);
+            }
+        }
+
+        void pad()
+        {
+            while (m_offset % 8 != 0) {
+                m_out.put('\0');
+                ++m_offset;
+            }
+        }
+
+    private:
+        fbxViz::OutputBuffer& m_out;
+        std::uint64_t m_offset{0};
+    };
+
+    // offset + count * size stays inside the file, without overflowing
+    bool inBounds(std::uint64_t offset, std::uint64_t count, std::uint64_t size, std::uint64_t fileSize)
+    {
+        return offset % 8 == 0 && offset <= fileSize && count <= (fileSize - offset) / size;
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+bool writeGraphSnapshot(const DGraph& graph, const std::vector<SnapshotCurve>& curves, std::string_view fileName)
+{
+    assert(graph.isFrozen());
+
+    const auto& nodes = graph.getNodes();
+    const auto nodeCount = nodes.size();
+
+    // the first curve of a node wins, like the first node of a key
+    std::vector<std::uint32_t> nodeCurve(nodeCount, InvalidNodeId);
+    std::vector<SnapshotCurveRecord> curveRecords;
+    std::vector<const SnapshotCurve*> curveSources;
+    std::uint64_t keyCount = 0;
+    for (const auto& curve : curves) {
+        if (curve.node >= nodeCount || nodeCurve[curve.node] != InvalidNodeId) {
+            continue;
+        }
+
+        nodeCurve[curve.node] = static_cast<std::uint32_t>(curveRecords.size());
+        curveRecords.push_back({ curve.node, 0, keyCount, curve.keyCount });
+        curveSources.push_back(&curve);
+        keyCount += curve.keyCount;
+    }
+
+    StringTable strings;
+    std::vector<SnapshotNode> nodeRecords(nodeCount);
+    std::vector<std::uint32_t> childOffsets(nodeCount + 1, 0);
+    std::vector<NodeId> children;
+    children.reserve(graph.getEdges().size());
+    for (NodeId id = 0; id < nodeCount; ++id) {
+        const auto& node = nodes[id];
+        const auto& key = graph.getKey(id);
+
+        nodeRecords[id] = { key.object, key.slot,
+                            strings.add(node.getName()),
+                            strings.add(node.getType()),
+                            strings.add(node.getDataInfo()),
+                            nodeCurve[id], 0 };
+
+        const auto nodeChildren = graph.children(id);
+        children.insert(children.end(), nodeChildren.begin(), nodeChildren.end());
+        childOffsets[id + 1] = static_cast<std::uint32_t>(children.size());
+    }
+
+    SnapshotHeader header{};
+    std::memcpy(header.magic, SnapshotMagic, sizeof(header.magic));
+    header.version = SnapshotVersion;
+    header.byteOrder = ByteOrderMark;
+    header.nodeCount = static_cast<std::uint32_t>(nodeCount);
+    header.edgeCount = static_cast<std::uint32_t>(children.size());
+    header.curveCount = static_cast<std::uint32_t>(curveRecords.size());
+    header.keyCount = keyCount;
+    header.stringPoolSize = strings.data().size();
+
+    header.nodes = align8(sizeof(SnapshotHeader));
+    header.childOffsets = align8(header.nodes + nodeCount * sizeof(SnapshotNode));
+    header.children = align8(header.childOffsets + childOffsets.size() * sizeof(std::uint32_t));
+    header.curves = align8(header.children + children.size() * sizeof(NodeId));
+    header.keyTimes = align8(header.curves + curveRecords.size() * sizeof(SnapshotCurveRecord));
+    header.keyValues = align8(header.keyTimes + keyCount * sizeof(std::int64_t));
+    header.leftDerivatives = align8(header.keyValues + keyCount * sizeof(float));
+    header.rightDerivatives = align8(header.leftDerivatives + keyCount * sizeof(float));
+    header.keyFlags = align8(header.rightDerivatives + keyCount * sizeof(float));
+    header.strings = align8(header.keyFlags + keyCount * sizeof(std::uint8_t));
+    header.fileSize = header.strings + header.stringPoolSize;
+
+    OutputBuffer out(fileName);
+    if (!out.isOpen()) {
+        return false;
+    }
+
+    SectionWriter writer(out);
+    writer.write(&header, 1);
+    writer.pad();
+    writer.write(nodeRecords.data(), nodeRecords.size());
+    writer.pad();
+    writer.write(childOffsets.data(), childOffsets.size());
+    writer.pad();
+    writer.write(children.data(), children.size());
+    writer.pad();
+    writer.write(curveRecords.data(), curveRecords.size());
+    writer.pad();
+
+    // the key arrays of all curves back to back, one section per array
+    for (const auto* curve : curveSources) {
+        writer.write(curve->times, curve->keyCount);
+    }
+    writer.pad();
+    for (const auto* curve : curveSources) {
+        writer.write(curve->values, curve->keyCount);
+    }
+    writer.pad();
+    for (const auto* curve : curveSources) {
+        writer.write(curve->leftDerivatives, curve->keyCount);
+    }
+    writer.pad();
+    for (const auto* curve : curveSources) {
+        writer.write(curve->rightDerivatives, curve->keyCount);
+    }
+    writer.pad();
+    for (const auto* curve : curveSources) {
+        writer.write(curve->flags, curve->keyCount);
+    }
+    writer.pad();
+    writer.write(strings.data().data(), strings.data().size());
+
+    out.close();
+
+    fmt::print("Generated snapshot to {} successfully!!! ({} nodes, {} curves, {} keys)\n",
+               out.fileName(), nodeCount, curveRecords.size(), keyCount);
+    return true;
+}
+
+bool GraphSnapshot::open(std::string_view fileName)
+{
+    close();
+
+    if (!m_file.open(fileName)) {
+        return false;
+    }
+
+    const auto fileSize = static_cast<std::uint64_t>(m_file.size());
+    const auto* header = reinterpret_cast<const SnapshotHeader*>(m_file.data());
+
+    if (fileSize < sizeof(SnapshotHeader) || std::memcmp(header->magic, SnapshotMagic, sizeof(SnapshotMagic)) != 0) {
+        fmt::print("Error: {} is not a graph snapshot!\n", fileName);
+        close();
+        return false;
+    }
+
+    if (header->version != SnapshotVersion || header->byteOrder != ByteOrderMark) {
+        fmt::print("Error: {} has snapshot version {}, expected {} in native byte order!\n",
+                   fileName, header->version, SnapshotVersion);
+        close();
+        return false;
+    }
+
+    const bool valid = header->fileSize == fileSize
+        && inBounds(header->nodes, header->nodeCount, sizeof(SnapshotNode), fileSize)
+        && inBounds(header->childOffsets, std::uint64_t(header->nodeCount) + 1, sizeof(std::uint32_t), fileSize)
+        && inBounds(header->children, header->edgeCount, sizeof(NodeId), fileSize)
+        && inBounds(header->curves, header->curveCount, sizeof(SnapshotCurveRecord), fileSize)
+        && inBounds(header->keyTimes, header->keyCount, sizeof(std::int64_t), fileSize)
+        && inBounds(header->keyValues, header->keyCount, sizeof(float), fileSize)
+        && inBounds(header->leftDerivatives, header->keyCount, sizeof(float), fileSize)
+        && inBounds(header->rightDerivatives, header->keyCount, sizeof(float), fileSize)
+        && inBounds(header->keyFlags, header->keyCount, sizeof(std::uint8_t), fileSize)
+        && inBounds(header->strings, header->stringPoolSize, 1, fileSize);
+
+    if (!valid) {
+        fmt::print("Error: {} is truncated or corrupt!\n", fileName);
+        close();
+        return false;
+    }
+
+    m_header = header;
+    m_nodes = section<SnapshotNode>(header->nodes);
+    m_childOffsets = section<std::uint32_t>(header->childOffsets);
+    m_children = section<NodeId>(header->children);
+    m_curves = section<SnapshotCurveRecord>(header->curves);
+    m_strings = section<char>(header->strings);
+    return true;
+}
+
+void GraphSnapshot::close()
+{
+    m_file.close();
+    m_header = nullptr;
+    m_nodes = nullptr;
+    m_childOffsets = nullptr;
+    m_children = nullptr;
+    m_curves = nullptr;
+    m_strings = nullptr;
+}
+
+std::size_t GraphSnapshot::nodeCount() const
+{
+    return m_header ? m_header->nodeCount : 0;
+}
+
+NodeKey GraphSnapshot::key(NodeId id) const
+{
+    assert(id < nodeCount());
+
+    NodeKey key;
+    key.object = m_nodes[id].keyObject;
+    key.slot = m_nodes[id].keySlot;
+    return key;
+}
+
+std::string_view GraphSnapshot::name(NodeId id) const
+{
+    assert(id < nodeCount());
+    return string(m_nodes[id].name);
+}
+
+std::string_view GraphSnapshot::type(NodeId id) const
+{
+    assert(id < nodeCount());
+    return string(m_nodes[id].type);
+}
+
+std::string_view GraphSnapshot::dataInfo(NodeId id) const
+{
+    assert(id < nodeCount());
+    return string(m_nodes[id].dataInfo);
+}
+
+NodeRange GraphSnapshot::children(NodeId id) const
+{
+    assert(id < nodeCount());
+
+    // offsets of a corrupt file are clamped instead of trusted
+    const std::uint32_t edgeCount = m_header->edgeCount;
+    const auto first = std::min(m_childOffsets[id], edgeCount);
+    const auto last = std::max(first, std::min(m_childOffsets[id + 1], edgeCount));
+    return NodeRange(m_children + first, m_children + last);
+}
+
+void GraphSnapshot::visitSubtree(NodeId root, const std::function<void(NodeId id, std::size_t depth)>& visitor) const
+{
+    struct Entry
+    {
+        NodeId id;
+        std::size_t depth;
+    };
+
+    const auto count = nodeCount();
+    if (root >= count) {
+        return;
+    }
+
+    std::vector<Entry> stack{ { root, 0 } };
+    while (!stack.empty()) {
+        const auto entry = stack.back();
+        stack.pop_back();
+
+        visitor(entry.id, entry.depth);
+
+        // no path is longer than the node count, unless a corrupt file has a cycle
+        if (entry.depth + 1 >= count) {
+            continue;
+        }
+
+        // pushed in reverse so children are visited in order
+        const auto nodeChildren = children(entry.id);
+        for (auto it = nodeChildren.end(); it != nodeChildren.begin();) {
+            --it;
+            if (*it < count) {
+                stack.push_back({ *it, entry.depth + 1 });
+            }
+        }
+    }
+}
+
+std::size_t GraphSnapshot::curveCount() const
+{
+    return m_header ? m_header->curveCount : 0;
+}
+
+SnapshotCurve GraphSnapshot::curve(std::size_t index) const
+{
+    assert(index < curveCount());
+
+    const auto& record = m_curves[index];
+
+    SnapshotCurve curve;
+    if (record.firstKey > m_header->keyCount || record.keyCount > m_header->keyCount - record.firstKey) {
+        return curve;
+    }
+
+    curve.node = record.node;
+    curve.keyCount = static_cast<std::size_t>(record.keyCount);
+    curve.times = section<std::int64_t>(m_header->keyTimes) + record.firstKey;
+    curve.values = section<float>(m_header->keyValues) + record.firstKey;
+    curve.leftDerivatives = section<float>(m_header->leftDerivatives) + record.firstKey;
+    curve.rightDerivatives = section<float>(m_header->rightDerivatives) + record.firstKey;
+    curve.flags = section<std::uint8_t>(m_header->keyFlags) + record.firstKey;
+    return curve;
+}
+
+bool GraphSnapshot::findCurve(NodeId id, SnapshotCurve& curve) const
+{
+    assert(id < nodeCount());
+
+    const auto index = m_nodes[id].curve;
+    if (index >= curveCount()) {
+        return false;
+    }
+
+    curve = this->curve(index);
+    return true;
+}
+
+std::string_view GraphSnapshot::string(const SnapshotString& str) const
+{
+    const auto poolSize = m_header->stringPoolSize;
+    if (str.offset > poolSize || str.length > poolSize - str.offset) {
+        return {};
+    }
+
+    return std::string_view(m_strings + str.offset, static_cast<std::size_t>(str.length));
+}
+
+} // namespace fbxViz
@@ -0,0 +1,166 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "graph.h"
+#include "mappedFile.h"
+
+#include <cstdint>
+#include <functional>
+#include <string_view>
+#include <vector>
+
+namespace fbxViz {
+
+// Binary snapshot of a frozen DGraph, laid out to be memory mapped and used
+// in place. All sections start on an 8 byte boundary and are stored in the
+// byte order of the writer, which readers check against the header.
+//
+//   SnapshotHeader
+//   SnapshotNode[nodeCount]          keys and string pool references
+//   uint32[nodeCount + 1]            CSR child offsets
+//   NodeId[edgeCount]                CSR children
+//   SnapshotCurveRecord[curveCount]  the node and key range of every curve
+//   int64[keyCount]                  key times in FbxTime ticks
+//   float[keyCount]                  key values
+//   float[keyCount]                  left derivatives
+//   float[keyCount]                  right derivatives
+//   uint8[keyCount]                  key flags, see CurveSnapshot
+//   char[stringPoolSize]             names, types and data infos, deduplicated
+constexpr std::uint32_t SnapshotVersion = 1;
+
+struct SnapshotString
+{
+    std::uint64_t offset;
+    std::uint64_t length;
+};
+
+struct SnapshotHeader
+{
+    char magic[8];
+    std::uint32_t version;
+    std::uint32_t byteOrder;
+    std::uint32_t nodeCount;
+    std::uint32_t edgeCount;
+    std::uint32_t curveCount;
+    std::uint32_t reserved;
+    std::uint64_t keyCount;
+    std::uint64_t stringPoolSize;
+    std::uint64_t fileSize;
+
+    // section offsets from the start of the file
+    std::uint64_t nodes;
+    std::uint64_t childOffsets;
+    std::uint64_t children;
+    std::uint64_t curves;
+    std::uint64_t keyTimes;
+    std::uint64_t keyValues;
+    std::uint64_t leftDerivatives;
+    std::uint64_t rightDerivatives;
+    std::uint64_t keyFlags;
+    std::uint64_t strings;
+};
+
+struct SnapshotNode
+{
+    std::uint64_t keyObject;
+    std::uint64_t keySlot;
+    SnapshotString name;
+    SnapshotString type;
+    SnapshotString dataInfo;
+    std::uint32_t curve;    // index into the curve records or InvalidNodeId
+    std::uint32_t reserved;
+};
+
+struct SnapshotCurveRecord
+{
+    NodeId node;
+    std::uint32_t reserved;
+    std::uint64_t firstKey;
+    std::uint64_t keyCount;
+};
+
+// the key arrays of one curve, views into the caller's arrays when writing
+// and into the mapped file when reading
+struct SnapshotCurve
+{
+    NodeId node{InvalidNodeId};
+    std::size_t keyCount{0};
+    const std::int64_t* times{nullptr};
+    const float* values{nullptr};
+    const float* leftDerivatives{nullptr};
+    const float* rightDerivatives{nullptr};
+    const std::uint8_t* flags{nullptr};
+};
+
+// writes the graph, which must be frozen, and the curves of its nodes
+bool writeGraphSnapshot(const DGraph& graph, const std::vector<SnapshotCurve>& curves, std::string_view fileName);
+
+// read only view of a mapped snapshot. Opening only validates the header
+// and the section bounds, nodes and curves are read on access.
+class GraphSnapshot final
+{
+public:
+    GraphSnapshot() = default;
+
+    bool open(std::string_view fileName);
+    void close();
+
+    std::size_t nodeCount() const;
+    NodeKey key(NodeId id) const;
+    std::string_view name(NodeId id) const;
+    std::string_view type(NodeId id) const;
+    std::string_view dataInfo(NodeId id) const;
+
+    NodeRange children(NodeId id) const;
+
+    // depth first pre-order walk below and including root, iterative so
+    // deep hierarchies do not exhaust the stack
+    void visitSubtree(NodeId root, const std::function<void(NodeId id, std::size_t depth)>& visitor) const;
+
+    std::size_t curveCount() const;
+    SnapshotCurve curve(std::size_t index) const;
+
+    // the curve attached to a node, false if it has none
+    bool findCurve(NodeId id, SnapshotCurve& curve) const;
+
+private:
+    template <typename T>
+    const T* section(std::uint64_t offset) const
+    {
+        return reinterpret_cast<const T*>(m_file.data() + offset);
+    }
+
+    std::string_view string(const SnapshotString& str) const;
+
+    MappedFile m_file;
+    const SnapshotHeader* m_header{nullptr};
+    const SnapshotNode* m_nodes{nullptr};
+    const std::uint32_t* m_childOffsets{nullptr};
+    const NodeId* m_children{nullptr};
+    const SnapshotCurveRecord* m_curves{nullptr};
+    const char* m_strings{nullptr};
+};
+
+} // namespace fbxViz
@@ -0,0 +1,144 @@
+#include "graphWriter.h"
+#include "dotWriter.h"
+#include "edgeListWriter.h"
+#include "graphMlWriter.h"
+#include "jsonWriter.h"
+
+#include <fmt/core.h>
+
+namespace fbxViz {
+
+std::string_view graphFormatExtension(GraphFormat format)
+{
+    switch (format) {
+        case GraphFormat::Dot: return ".dot";
+        case GraphFormat::Json: return ".ndjson";
+        case GraphFormat::GraphMl: return ".graphml";
+        case GraphFormat::EdgeList: return ".edges";
+    }
+
+    return ".dot";
+}
+
+GraphWriter::GraphWriter(std::string_view fileName, std::size_t bufferSize)
+    : m_out(fileName, bufferSize, compressionFromFileName(fileName))
+{
+}
+
+bool GraphWriter::isOpen() const
+{
+    return m_out.isOpen();
+}
+
+void GraphWriter::close()
+{
+    if (!m_out.isOpen()) {
+        return;
+    }
+
+    writeFooter();
+    m_out.close();
+
+    constexpr double MegaByte = 1024.0 * 1024.0;
+    if (m_out.compression() == Compression::None) {
+        fmt::print("Generated graph to {} successfully!!! ({:.2f} MB, {:.1f} MB/s)\n",
+                   m_out.fileName(), m_out.bytesWritten() / MegaByte, m_out.bytesPerSecond() / MegaByte);
+    } else {
+        fmt::print("Generated graph to {} successfully!!! ({:.2f} MB, {:.2f} MB compressed, {:.1f} MB/s)\n",
+                   m_out.fileName(), m_out.bytesFormatted() / MegaByte, m_out.bytesWritten() / MegaByte,
+                   m_out.bytesPerSecond() / MegaByte);
+    }
+}
+
+std::unique_ptr<GraphWriter> createGraphWriter(GraphFormat format, DotStyle style, std::string_view fileName, std::size_t bufferSize)
+{
+    std::unique_ptr<GraphWriter> writer;
+    switch (format) {
+        case GraphFormat::Dot:
+            writer = std::make_unique<DotWriter>(fileName, bufferSize, style);
+            break;
+        case GraphFormat::Json:
+            writer = std::make_unique<JsonWriter>(fileName, bufferSize);
+            break;
+        case GraphFormat::GraphMl:
+            writer = std::make_unique<GraphMlWriter>(fileName, bufferSize);
+            break;
+        case GraphFormat::EdgeList:
+            writer = std::make_unique<EdgeListWriter>(fileName, bufferSize);
+            break;
+    }
+
+    if (!writer || !writer->isOpen()) {
+        return nullptr;
+    }
+
+    return writer;
+}
+
+GraphStreamWriter::GraphStreamWriter(std::string_view fileName, std::string_view graphName, GraphFormat format, DotStyle style)
+    : m_writer(createGraphWriter(format, style, fileName, BufferSize))
+{
+    if (m_writer) {
+        m_writer->writeHeader(graphName);
+    }
+}
+
+GraphStreamWriter::~GraphStreamWriter()
+{
+    close();
+}
+
+NodeId GraphStreamWriter::findNode(const NodeKey& key) const
+{
+    auto it = m_nodeIndex.find(key);
+    return it != m_nodeIndex.end() ? it->second : InvalidNodeId;
+}
+
+NodeId GraphStreamWriter::addNode(const NodeKey& key, const Node& node)
+{
+    auto [it, inserted] = m_nodeIndex.try_emplace(key, static_cast<NodeId>(m_nodeIndex.size()));
+    if (inserted) {
+        m_firstParents.push_back(InvalidNodeId);
+        if (m_writer) {
+            m_writer->writeNode(it->second, node);
+        }
+    }
+
+    return it->second;
+}
+
+void GraphStreamWriter::addEdge(const NodeRef& src, const NodeRef& dest)
+{
+    // the same edges DGraph keeps, a node reached again through another
+    // layer does not get a second arrow
+    auto& firstParent = m_firstParents[dest.id];
+    if (firstParent == InvalidNodeId) {
+        firstParent = src.id;
+    } else if (firstParent == src.id || !m_extraEdges.insert((static_cast<std::uint64_t>(src.id) << 32) | dest.id).second) {
+        return;
+    }
+
+    if (m_writer) {
+        m_writer->writeEdge(src, dest);
+    }
+    ++m_edgeCount;
+}
+
+void GraphStreamWriter::close()
+{
+    if (m_writer) {
+        m_writer->close();
+    }
+}
+
+std::size_t GraphStreamWriter::nodeCount() const
+{
+    return m_nodeIndex.size();
+}
+
+std::size_t GraphStreamWriter::edgeCount() const
+{
+    return m_edgeCount;
+}
+
+} // namespace fbxViz
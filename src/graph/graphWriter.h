@@ -0,0 +1,125 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "graphFormat.h"
+#include "graphSink.h"
+#include "node.h"
+#include "outputBuffer.h"
+
+#include <memory>
+#include <string_view>
+#include <unordered_map>
+#include <unordered_set>
+#include <vector>
+
+namespace fbxViz {
+
+// how the DOT writer draws the nodes, the other formats ignore it
+enum class DotStyle
+{
+    Dag,        // shape by node type, data info rows such as the motion bounds
+    AnimStack,  // boxes with the data info rows
+    Diff        // boxes with the data info rows, filled by the change in the type
+};
+
+// writes the nodes and edges of a graph in one output format, either from a
+// complete DGraph or while a scene is traversed. A node is always written
+// before the edges that reference it. File names ending in .gz or .zst are
+// compressed on the fly.
+class GraphWriter
+{
+public:
+    GraphWriter(std::string_view fileName, std::size_t bufferSize);
+    virtual ~GraphWriter() = default;
+
+    // delete copy and move
+    GraphWriter(const GraphWriter& other) = delete;
+    GraphWriter& operator=(const GraphWriter& other) = delete;
+    GraphWriter(GraphWriter&& other) = delete;
+    GraphWriter& operator=(GraphWriter&& other) = delete;
+
+    bool isOpen() const;
+
+    virtual void writeHeader(std::string_view graphName) = 0;
+    virtual void writeNode(NodeId id, const Node& node) = 0;
+
+    // every format refers to the nodes by id
+    virtual void writeEdge(const NodeRef& src, const NodeRef& dest) = 0;
+
+    // ends the document, closes the file and reports the throughput
+    void close();
+
+protected:
+    virtual void writeFooter() = 0;
+
+    OutputBuffer m_out;
+};
+
+std::unique_ptr<GraphWriter> createGraphWriter(GraphFormat format, DotStyle style, std::string_view fileName,
+                                               std::size_t bufferSize = OutputBuffer::DefaultCapacity);
+
+// writes nodes and edges as soon as they are added, through a small fixed
+// size buffer. The nodes themselves are never stored, only the keys of the
+// emitted nodes and the first parent of each to drop repeated nodes and
+// edges, so memory grows with the node count but not with the labels.
+class GraphStreamWriter final : public GraphSink
+{
+public:
+    GraphStreamWriter(std::string_view fileName, std::string_view graphName, GraphFormat format, DotStyle style);
+    ~GraphStreamWriter() override;
+
+    // delete copy and move
+    GraphStreamWriter(const GraphStreamWriter& other) = delete;
+    GraphStreamWriter& operator=(const GraphStreamWriter& other) = delete;
+    GraphStreamWriter(GraphStreamWriter&& other) = delete;
+    GraphStreamWriter& operator=(GraphStreamWriter&& other) = delete;
+
+    NodeId findNode(const NodeKey& key) const override;
+    NodeId addNode(const NodeKey& key, const Node& node) override;
+    void addEdge(const NodeRef& src, const NodeRef& dest) override;
+
+    // ends the document and flushes the file
+    void close();
+
+    // nodes and edges written so far, each counted once
+    std::size_t nodeCount() const;
+    std::size_t edgeCount() const;
+
+private:
+    static constexpr std::size_t BufferSize = 64 * 1024;
+
+    std::unique_ptr<GraphWriter> m_writer;
+
+    std::unordered_map<NodeKey, NodeId, NodeKeyHash> m_nodeIndex;
+
+    // the source of the first edge into each node. Nodes with more than one
+    // parent, e.g. a property animated in several layers, keep their other
+    // edges in m_extraEdges as src << 32 | dest.
+    std::vector<NodeId> m_firstParents;
+    std::unordered_set<std::uint64_t> m_extraEdges;
+    std::size_t m_edgeCount{0};
+};
+
+} // namespace fbxViz
@@ -0,0 +1,112 @@
+#include "jsonWriter.h"
+#include "nodeData.h"
+
+#include <cctype>
+
+namespace {
+
+    void writeString(fbxViz::OutputBuffer& out, std::string_view text)
+    {
+        out.put('"');
+
+        std::size_t pos = 0;
+        for (std::size_t i = 0; i < text.size(); ++i) {
+            const auto c = static_cast<unsigned char>(text[i]);
+            if (c >= 0x20 && c != '"' && c != '\\') {
+                continue;
+            }
+
+            out.write(text.substr(pos, i - pos));
+            switch (c) {
+                case '"': out.write("\\\""); break;
+                case '\\': out.write("\\\\"); break;
+                case '\n': out.write("\\n"); break;
+                case '\t': out.write("\\t"); break;
+                default: out.format("\\u{:04x}", static_cast<unsigned>(c)); break;
+            }
+            pos = i + 1;
+        }
+        out.write(text.substr(pos));
+
+        out.put('"');
+    }
+
+    // numeric fields are written as JSON numbers, "nan" and "inf" as null
+    void writeNumber(fbxViz::OutputBuffer& out, std::string_view value)
+    {
+        const auto digit = value.empty() || value[0] != '-' ? 0 : 1;
+        if (value.size() > std::size_t(digit) && std::isdigit(static_cast<unsigned char>(value[digit]))) {
+            out.write(value);
+        } else {
+            out.write("null");
+        }
+    }
+
+    void writeData(fbxViz::OutputBuffer& out, std::string_view data)
+    {
+        fbxViz::NodeDataCursor cursor(data);
+        fbxViz::NodeDataField field;
+
+        std::string_view rowSeparator = ",\"data\":[";
+        while (cursor.nextRow()) {
+            out.write(rowSeparator);
+            rowSeparator = ",";
+
+            out.put('{');
+            std::string_view fieldSeparator;
+            while (cursor.nextField(field)) {
+                out.write(fieldSeparator);
+                fieldSeparator = ",";
+
+                writeString(out, field.name.empty() ? "text" : field.name);
+                out.put(':');
+                if (field.numeric) {
+                    writeNumber(out, field.value);
+                } else {
+                    writeString(out, field.value);
+                }
+            }
+            out.put('}');
+        }
+
+        if (rowSeparator == ",") {
+            out.put(']');
+        }
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+JsonWriter::JsonWriter(std::string_view fileName, std::size_t bufferSize)
+    : GraphWriter(fileName, bufferSize)
+{
+}
+
+void JsonWriter::writeHeader(std::string_view graphName)
+{
+    m_out.write("{\"graph\":");
+    writeString(m_out, graphName);
+    m_out.write("}\n");
+}
+
+void JsonWriter::writeNode(NodeId id, const Node& node)
+{
+    m_out.format("{{\"kind\":\"node\",\"id\":{},\"name\":", id);
+    writeString(m_out, node.getName());
+    m_out.write(",\"type\":");
+    writeString(m_out, node.getType());
+    writeData(m_out, node.getDataInfo());
+    m_out.write("}\n");
+}
+
+void JsonWriter::writeEdge(const NodeRef& src, const NodeRef& dest)
+{
+    m_out.format("{{\"kind\":\"edge\",\"src\":{},\"dest\":{}}}\n", src.id, dest.id);
+}
+
+void JsonWriter::writeFooter()
+{
+}
+
+} // namespace fbxViz
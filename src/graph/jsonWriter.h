@@ -0,0 +1,51 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "graphWriter.h"
+
+#include <string_view>
+
+namespace fbxViz {
+
+// newline delimited JSON, one object per line that can be parsed on its own:
+//   {"graph":"dag_scene"}
+//   {"kind":"node","id":0,"name":"root","type":"","data":[{"Key counts":2}]}
+//   {"kind":"edge","src":0,"dest":1}
+// The data rows of a node become objects keyed by field name, free text
+// fields are keyed "text". Nodes without data have no "data" array.
+class JsonWriter final : public GraphWriter
+{
+public:
+    JsonWriter(std::string_view fileName, std::size_t bufferSize);
+
+    void writeHeader(std::string_view graphName) override;
+    void writeNode(NodeId id, const Node& node) override;
+    void writeEdge(const NodeRef& src, const NodeRef& dest) override;
+
+protected:
+    void writeFooter() override;
+};
+
+} // namespace fbxViz
@@ -1,13 +1,46 @@
 #include "node.h"
 
-#include <algorithm>
+namespace {
+
+    // 64-bit FNV-1a
+    std::uint64_t hashString(std::string_view str)
+    {
+        std::uint64_t hash = 14695981039346656037ull;
+        for (auto c : str) {
+            hash ^= static_cast<unsigned char>(c);
+            hash *= 1099511628211ull;
+        }
+        return hash;
+    }
+
+} // namespace
 
 namespace fbxViz {
 
+NodeKey::NodeKey(std::uint64_t objectId, std::string_view slotName)
+    : object(objectId)
+    , slot(slotName.empty() ? 0 : hashString(slotName))
+{
+}
+
+bool NodeKey::operator==(const NodeKey& other) const
+{
+    return object == other.object && slot == other.slot;
+}
+
+std::size_t NodeKeyHash::operator()(const NodeKey& key) const
+{
+    // splitmix64 finalizer, object IDs are mostly sequential
+    std::uint64_t hash = key.object ^ (key.slot * 0x9e3779b97f4a7c15ull);
+    hash = (hash ^ (hash >> 30)) * 0xbf58476d1ce4e5b9ull;
+    hash = (hash ^ (hash >> 27)) * 0x94d049bb133111ebull;
+    return static_cast<std::size_t>(hash ^ (hash >> 31));
+}
+
+
 Node::Node(std::string_view nodeName)
     : m_name( nodeName )
 {
-    std::replace(m_name.begin(), m_name.end(), ' ', '_');
 }
 
 void Node::setType(std::string_view typeName)
@@ -15,7 +48,7 @@ void Node::setType(std::string_view typeName)
     m_type = typeName;
 }
 
-const std::string& Node::getType() const
+std::string_view Node::getType() const
 {
     return m_type;
 }
@@ -23,10 +56,9 @@ const std::string& Node::getType() const
 void Node::setName(std::string_view nodeName)
 {
     m_name = nodeName;
-    std::replace(m_name.begin(), m_name.end(), ' ', '_');
 }
 
-const std::string& Node::getName() const
+std::string_view Node::getName() const
 {
     return m_name;
 }
@@ -36,9 +68,19 @@ void Node::setDataInfo(std::string_view info)
     m_dataInfo = info;
 }
 
-const std::string& Node::getDataInfo() const
+std::string_view Node::getDataInfo() const
 {
     return m_dataInfo;
 }
 
+void Node::setFillColor(std::string_view color)
+{
+    m_fillColor = color;
+}
+
+std::string_view Node::getFillColor() const
+{
+    return m_fillColor;
+}
+
 } // namespace fbxViz
@@ -23,17 +23,44 @@
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
 #pragma once
 
-#include <string>
+#include <cstdint>
+#include <limits>
 #include <string_view>
 
 namespace fbxViz {
 
+// index of a node inside its owning graph
+using NodeId = std::uint32_t;
+constexpr NodeId InvalidNodeId = std::numeric_limits<NodeId>::max();
+
+// identity of a node in the source scene. Nodes that map one to one onto an
+// FBX object use its unique ID, nodes derived from a part of an object
+// ( e.g. an animated property channel ) also carry a hashed slot name.
+struct NodeKey
+{
+    NodeKey() = default;
+    explicit NodeKey(std::uint64_t objectId, std::string_view slotName = {});
+
+    bool operator==(const NodeKey& other) const;
+
+    std::uint64_t object{0};
+    std::uint64_t slot{0};
+};
+
+struct NodeKeyHash
+{
+    std::size_t operator()(const NodeKey& key) const;
+};
+
+// a node of a graph. The strings are views, DGraph copies them into its
+// string pool when the node is added, so they only have to live until the
+// addNode() call returns.
 class Node final
 {
 public:
     Node() = default;
     Node(std::string_view name);
-    virtual ~Node() = default;
+    ~Node() = default;
 
     Node(const Node& other) = default;
     Node& operator=(const Node& other) = default;
@@ -41,18 +68,23 @@ public:
     Node& operator=(Node&& other) = default;
 
     void setName(std::string_view nodeName);
-    const std::string& getName() const;
+    std::string_view getName() const;
 
     void setType(std::string_view typeName);
-    const std::string& getType() const;
+    std::string_view getType() const;
 
     void setDataInfo(std::string_view info);
-    const std::string& getDataInfo() const;
+    std::string_view getDataInfo() const;
+
+    // "#rrggbb" overriding the fill color of the DOT style, empty by default
+    void setFillColor(std::string_view color);
+    std::string_view getFillColor() const;
 
 private:
-    std::string m_name;
-    std::string m_type;
-    std::string m_dataInfo;
+    std::string_view m_name;
+    std::string_view m_type;
+    std::string_view m_dataInfo;
+    std::string_view m_fillColor;
 };
 
 } // namespace fbxViz
@@ -0,0 +1,117 @@
+#include "nodeData.h"
+
+#include <fmt/format.h>
+
+#include <iterator>
+
+namespace {
+
+    // a row starts with RowStart, a field is kind, name, NameEnd, value, FieldEnd
+    constexpr char RowStart = '\n';
+    constexpr char NameEnd = '\x1f';
+    constexpr char FieldEnd = '\x1e';
+
+    constexpr char TextField = 's';
+    constexpr char NumberField = 'n';
+
+} // namespace
+
+namespace fbxViz {
+
+NodeDataBuilder::NodeDataBuilder(std::string& data)
+    : m_data(data)
+{
+}
+
+NodeDataBuilder& NodeDataBuilder::row()
+{
+    m_data.push_back(RowStart);
+    return *this;
+}
+
+NodeDataBuilder& NodeDataBuilder::text(std::string_view value)
+{
+    return field({}, value);
+}
+
+NodeDataBuilder& NodeDataBuilder::field(std::string_view name, std::string_view value)
+{
+    beginField(TextField, name);
+    m_data.append(value);
+    m_data.push_back(FieldEnd);
+    return *this;
+}
+
+NodeDataBuilder& NodeDataBuilder::integerField(std::string_view name, std::int64_t value)
+{
+    beginField(NumberField, name);
+    fmt::format_to(std::back_inserter(m_data), "{}", value);
+    m_data.push_back(FieldEnd);
+    return *this;
+}
+
+NodeDataBuilder& NodeDataBuilder::integerField(std::string_view name, std::uint64_t value)
+{
+    beginField(NumberField, name);
+    fmt::format_to(std::back_inserter(m_data), "{}", value);
+    m_data.push_back(FieldEnd);
+    return *this;
+}
+
+NodeDataBuilder& NodeDataBuilder::field(std::string_view name, double value, int precision)
+{
+    beginField(NumberField, name);
+    fmt::format_to(std::back_inserter(m_data), "{:.{}f}", value, precision);
+    m_data.push_back(FieldEnd);
+    return *this;
+}
+
+void NodeDataBuilder::beginField(char kind, std::string_view name)
+{
+    m_data.push_back(kind);
+    m_data.append(name);
+    m_data.push_back(NameEnd);
+}
+
+NodeDataCursor::NodeDataCursor(std::string_view data)
+    : m_data(data)
+{
+}
+
+bool NodeDataCursor::nextRow()
+{
+    m_pos = m_data.find(RowStart, m_rowEnd);
+    if (m_pos == std::string_view::npos) {
+        m_pos = m_rowEnd = m_data.size();
+        return false;
+    }
+
+    ++m_pos;
+    m_rowEnd = m_data.find(RowStart, m_pos);
+    if (m_rowEnd == std::string_view::npos) {
+        m_rowEnd = m_data.size();
+    }
+    return true;
+}
+
+bool NodeDataCursor::nextField(NodeDataField& field)
+{
+    if (m_pos >= m_rowEnd) {
+        return false;
+    }
+
+    const auto nameEnd = m_data.find(NameEnd, m_pos);
+    const auto fieldEnd = m_data.find(FieldEnd, nameEnd);
+    if (nameEnd >= m_rowEnd || fieldEnd >= m_rowEnd) {
+        m_pos = m_rowEnd;
+        return false;
+    }
+
+    field.numeric = m_data[m_pos] == NumberField;
+    field.name = m_data.substr(m_pos + 1, nameEnd - m_pos - 1);
+    field.value = m_data.substr(nameEnd + 1, fieldEnd - nameEnd - 1);
+    m_pos = fieldEnd + 1;
+    return true;
+}
+
+} // namespace fbxViz
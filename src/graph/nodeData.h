@@ -0,0 +1,91 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <type_traits>
+
+namespace fbxViz {
+
+// the data of a node, e.g. the keys of a curve, as rows of fields without
+// any markup. Each graph writer renders them its own way, DOT as label table
+// rows and JSON as arrays of objects, so formats that do not show them never
+// pay for the HTML. The rows are packed into the data info string of the node.
+struct NodeDataField
+{
+    std::string_view name;      // empty for free text
+    std::string_view value;
+    bool numeric{false};
+};
+
+// appends rows to a data info string. Packed strings can be concatenated.
+class NodeDataBuilder final
+{
+public:
+    explicit NodeDataBuilder(std::string& data);
+
+    // starts a new row, the fields are added to the last row started
+    NodeDataBuilder& row();
+
+    NodeDataBuilder& text(std::string_view value);
+    NodeDataBuilder& field(std::string_view name, std::string_view value);
+    NodeDataBuilder& field(std::string_view name, double value, int precision = 6);
+
+    template <typename Integer, typename = std::enable_if_t<std::is_integral<Integer>::value>>
+    NodeDataBuilder& field(std::string_view name, Integer value)
+    {
+        if constexpr (std::is_signed<Integer>::value) {
+            return integerField(name, static_cast<std::int64_t>(value));
+        } else {
+            return integerField(name, static_cast<std::uint64_t>(value));
+        }
+    }
+
+private:
+    NodeDataBuilder& integerField(std::string_view name, std::int64_t value);
+    NodeDataBuilder& integerField(std::string_view name, std::uint64_t value);
+    void beginField(char kind, std::string_view name);
+
+    std::string& m_data;
+};
+
+// reads packed rows back:
+//   while (cursor.nextRow()) { while (cursor.nextField(field)) { ... } }
+class NodeDataCursor final
+{
+public:
+    explicit NodeDataCursor(std::string_view data);
+
+    bool nextRow();
+    bool nextField(NodeDataField& field);
+
+private:
+    std::string_view m_data;
+    std::size_t m_pos{0};
+    std::size_t m_rowEnd{0};
+};
+
+} // namespace fbxViz
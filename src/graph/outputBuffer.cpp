@@ -0,0 +1,169 @@
+#include "outputBuffer.h"
+
+namespace fbxViz {
+
+OutputBuffer::OutputBuffer(std::string_view fileName, std::size_t capacity, Compression compression)
+    : m_fileName(fileName)
+    , m_capacity(capacity)
+    , m_compression(compression)
+    , m_start(std::chrono::steady_clock::now())
+    , m_stop(m_start)
+{
+    if (m_compression != Compression::None) {
+        m_compressor = Compressor::create(m_compression);
+        if (!m_compressor) {
+            fmt::print("Error: unable to write {}, FbxViz was built without {} support!\n",
+                       m_fileName, compressionExtension(m_compression));
+            return;
+        }
+    }
+
+    m_file = std::fopen(m_fileName.c_str(), "wb");
+    if (!m_file) {
+        fmt::print("Error: unable to open {} for writing!\n", m_fileName);
+        return;
+    }
+
+    // the buffer already batches the writes
+    std::setvbuf(m_file, nullptr, _IONBF, 0);
+
+    // leave some room so a formatted statement rarely reallocates
+    m_buffer.reserve(m_capacity + m_capacity / 4);
+
+    if (m_compressor) {
+        m_pending.reserve(m_buffer.capacity());
+        m_compressThread = std::thread(&OutputBuffer::compressLoop, this);
+    }
+}
+
+OutputBuffer::~OutputBuffer()
+{
+    close();
+}
+
+bool OutputBuffer::isOpen() const
+{
+    return m_file != nullptr;
+}
+
+void OutputBuffer::write(std::string_view text)
+{
+    m_buffer.append(text.data(), text.size());
+    flushIfFull();
+}
+
+void OutputBuffer::put(char c)
+{
+    m_buffer.push_back(c);
+    flushIfFull();
+}
+
+void OutputBuffer::flushIfFull()
+{
+    if (m_buffer.size() >= m_capacity) {
+        flush();
+    }
+}
+
+void OutputBuffer::flush()
+{
+    if (!m_file || m_buffer.empty()) {
+        m_buffer.clear();
+        return;
+    }
+
+    m_bytesFormatted += m_buffer.size();
+
+    if (!m_compressor) {
+        m_bytesWritten += std::fwrite(m_buffer.data(), 1, m_buffer.size(), m_file);
+        m_buffer.clear();
+        return;
+    }
+
+    // waits only when the compression falls a whole buffer behind
+    std::unique_lock<std::mutex> lock(m_mutex);
+    m_condition.wait(lock, [this] { return !m_hasPending; });
+    m_buffer.swap(m_pending);
+    m_hasPending = true;
+    lock.unlock();
+    m_condition.notify_all();
+}
+
+void OutputBuffer::compressLoop()
+{
+    for (;;) {
+        std::unique_lock<std::mutex> lock(m_mutex);
+        m_condition.wait(lock, [this] { return m_hasPending || m_closing; });
+        if (!m_hasPending) {
+            break;
+        }
+        lock.unlock();
+
+        m_bytesWritten += m_compressor->write(m_pending, m_file);
+
+        lock.lock();
+        m_pending.clear();
+        m_hasPending = false;
+        lock.unlock();
+        m_condition.notify_all();
+    }
+
+    m_bytesWritten += m_compressor->finish(m_file);
+}
+
+void OutputBuffer::close()
+{
+    if (!m_file) {
+        return;
+    }
+
+    flush();
+
+    if (m_compressThread.joinable()) {
+        {
+            std::lock_guard<std::mutex> lock(m_mutex);
+            m_closing = true;
+        }
+        m_condition.notify_all();
+        m_compressThread.join();
+    }
+
+    std::fclose(m_file);
+    m_file = nullptr;
+
+    m_stop = std::chrono::steady_clock::now();
+}
+
+const std::string& OutputBuffer::fileName() const
+{
+    return m_fileName;
+}
+
+Compression OutputBuffer::compression() const
+{
+    return m_compression;
+}
+
+std::uint64_t OutputBuffer::bytesFormatted() const
+{
+    return m_bytesFormatted;
+}
+
+std::uint64_t OutputBuffer::bytesWritten() const
+{
+    return m_bytesWritten;
+}
+
+double OutputBuffer::elapsedSeconds() const
+{
+    auto stop = m_file ? std::chrono::steady_clock::now() : m_stop;
+    return std::chrono::duration<double>(stop - m_start).count();
+}
+
+double OutputBuffer::bytesPerSecond() const
+{
+    auto seconds = elapsedSeconds();
+    return seconds > 0.0 ? static_cast<double>(m_bytesFormatted) / seconds : 0.0;
+}
+
+} // namespace fbxViz
@@ -0,0 +1,121 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "compression.h"
+
+#include <fmt/format.h>
+
+#include <atomic>
+#include <chrono>
+#include <condition_variable>
+#include <cstdint>
+#include <cstdio>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace fbxViz {
+
+// file output for the graph writers. Text is formatted straight into one
+// large contiguous buffer with fmt and handed to the file in big chunks,
+// which avoids the per insert overhead of std::ostream.
+//
+// With compression a full buffer is handed to a compression thread and
+// formatting goes on in a second buffer meanwhile, so the compression and
+// the disk writes overlap with the formatting instead of adding to it.
+class OutputBuffer final
+{
+public:
+    static constexpr std::size_t DefaultCapacity = 1 << 20;
+
+    explicit OutputBuffer(std::string_view fileName, std::size_t capacity = DefaultCapacity,
+                          Compression compression = Compression::None);
+    ~OutputBuffer();
+
+    // delete copy and move
+    OutputBuffer(const OutputBuffer& other) = delete;
+    OutputBuffer& operator=(const OutputBuffer& other) = delete;
+    OutputBuffer(OutputBuffer&& other) = delete;
+    OutputBuffer& operator=(OutputBuffer&& other) = delete;
+
+    bool isOpen() const;
+
+    void write(std::string_view text);
+    void put(char c);
+
+    template <typename... Args>
+    void format(fmt::string_view formatStr, const Args&... args)
+    {
+        fmt::vformat_to(std::back_inserter(m_buffer), formatStr, fmt::make_format_args(args...));
+        flushIfFull();
+    }
+
+    // hands the buffered bytes to the file, or to the compression thread
+    void flush();
+    void close();
+
+    const std::string& fileName() const;
+    Compression compression() const;
+
+    // bytes formatted and bytes that went to the file, they differ with
+    // compression. The written count is final once the file is closed.
+    std::uint64_t bytesFormatted() const;
+    std::uint64_t bytesWritten() const;
+    double elapsedSeconds() const;
+
+    // formatted bytes per second
+    double bytesPerSecond() const;
+
+private:
+    void flushIfFull();
+    void compressLoop();
+
+    std::string m_fileName;
+    std::FILE* m_file{nullptr};
+
+    std::string m_buffer;
+    std::size_t m_capacity;
+
+    // the compression thread owns m_pending while m_hasPending is set and
+    // hands it back cleared, so the two buffers are swapped, never copied
+    Compression m_compression;
+    std::unique_ptr<Compressor> m_compressor;
+    std::thread m_compressThread;
+    std::mutex m_mutex;
+    std::condition_variable m_condition;
+    std::string m_pending;
+    bool m_hasPending{false};
+    bool m_closing{false};
+
+    std::uint64_t m_bytesFormatted{0};
+    std::atomic<std::uint64_t> m_bytesWritten{0};
+    std::chrono::steady_clock::time_point m_start;
+    std::chrono::steady_clock::time_point m_stop;
+};
+
+} // namespace fbxViz
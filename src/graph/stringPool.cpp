@@ -0,0 +1,130 @@
+#include "stringPool.h"
+
+#include <cstring>
+#include <functional>
+
+namespace fbxViz {
+
+std::string_view StringPool::store(std::string_view str)
+{
+    if (str.empty()) {
+        return {};
+    }
+
+    char* data = allocate(str.size());
+    std::memcpy(data, str.data(), str.size());
+    return { data, str.size() };
+}
+
+std::string_view StringPool::intern(std::string_view str)
+{
+    if (str.empty()) {
+        return {};
+    }
+
+    // kept at most half full
+    if (2 * (m_internedCount + 1) > m_slots.size()) {
+        growSlots();
+    }
+
+    const auto hash = std::hash<std::string_view>()(str);
+    const auto mask = m_slots.size() - 1;
+    for (auto i = hash & mask;; i = (i + 1) & mask) {
+        auto& slot = m_slots[i];
+        if (!slot.data) {
+            const auto pooled = store(str);
+            slot = { hash, pooled.data(), pooled.size() };
+            ++m_internedCount;
+            return pooled;
+        }
+        if (slot.hash == hash && std::string_view(slot.data, slot.size) == str) {
+            return { slot.data, slot.size };
+        }
+    }
+}
+
+void StringPool::splice(StringPool& other)
+{
+    // the current block stays the one strings are appended to
+    for (auto& block : other.m_blocks) {
+        m_blocks.push_back(std::move(block));
+    }
+    m_blockBytes += other.m_blockBytes;
+
+    for (const auto& slot : other.m_slots) {
+        if (!slot.data) {
+            continue;
+        }
+
+        if (2 * (m_internedCount + 1) > m_slots.size()) {
+            growSlots();
+        }
+        insertSlot(slot);
+    }
+
+    other.clear();
+}
+
+void StringPool::clear()
+{
+    m_blocks.clear();
+    m_cursor = nullptr;
+    m_available = 0;
+    m_blockBytes = 0;
+    m_slots.clear();
+    m_internedCount = 0;
+}
+
+char* StringPool::allocate(std::size_t size)
+{
+    if (size > m_available) {
+        // long strings get a block of their own and the current one is kept
+        if (size > BlockSize / 4) {
+            m_blocks.push_back(std::make_unique<char[]>(size));
+            m_blockBytes += size;
+            return m_blocks.back().get();
+        }
+
+        m_blocks.push_back(std::make_unique<char[]>(BlockSize));
+        m_blockBytes += BlockSize;
+        m_cursor = m_blocks.back().get();
+        m_available = BlockSize;
+    }
+
+    char* data = m_cursor;
+    m_cursor += size;
+    m_available -= size;
+    return data;
+}
+
+// adds the slot unless an equal string is interned already
+void StringPool::insertSlot(const Slot& slot)
+{
+    const auto mask = m_slots.size() - 1;
+    for (auto i = slot.hash & mask;; i = (i + 1) & mask) {
+        auto& target = m_slots[i];
+        if (!target.data) {
+            target = slot;
+            ++m_internedCount;
+            return;
+        }
+        if (target.hash == slot.hash && std::string_view(target.data, target.size) == std::string_view(slot.data, slot.size)) {
+            return;
+        }
+    }
+}
+
+void StringPool::growSlots()
+{
+    std::vector<Slot> slots(m_slots.empty() ? 64 : 2 * m_slots.size(), Slot{ 0, nullptr, 0 });
+    slots.swap(m_slots);
+
+    m_internedCount = 0;
+    for (const auto& slot : slots) {
+        if (slot.data) {
+            insertSlot(slot);
+        }
+    }
+}
+
+} // namespace fbxViz
@@ -0,0 +1,89 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace fbxViz {
+
+// append-only arena for the strings of a graph. Strings are copied into
+// large blocks that never move, so the views handed out stay valid until the
+// pool is cleared or destroyed. intern() keeps one copy of every distinct
+// string, for the names and types repeated across thousands of nodes.
+class StringPool final
+{
+public:
+    StringPool() = default;
+    ~StringPool() = default;
+
+    // delete copy and move, the handed out views point into the blocks
+    StringPool(const StringPool& other) = delete;
+    StringPool& operator=(const StringPool& other) = delete;
+    StringPool(StringPool&& other) = delete;
+    StringPool& operator=(StringPool&& other) = delete;
+
+    // copies str into the pool without looking for an equal string
+    std::string_view store(std::string_view str);
+
+    // the pooled copy of str, stored the first time it is seen
+    std::string_view intern(std::string_view str);
+
+    // takes over the blocks and the interned strings of other, views into
+    // other stay valid. other is left empty.
+    void splice(StringPool& other);
+
+    void clear();
+
+    std::size_t internedCount() const { return m_internedCount; }
+    std::size_t blockBytes() const { return m_blockBytes; }
+
+private:
+    static constexpr std::size_t BlockSize = 64 * 1024;
+
+    // open addressing with linear probing, a null data pointer marks a free slot
+    struct Slot
+    {
+        std::size_t hash;
+        const char* data;
+        std::size_t size;
+    };
+
+    char* allocate(std::size_t size);
+    void insertSlot(const Slot& slot);
+    void growSlots();
+
+    std::vector<std::unique_ptr<char[]>> m_blocks;
+    char* m_cursor{nullptr};
+    std::size_t m_available{0};
+    std::size_t m_blockBytes{0};
+
+    std::vector<Slot> m_slots;
+    std::size_t m_internedCount{0};
+};
+
+} // namespace fbxViz
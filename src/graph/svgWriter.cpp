@@ -0,0 +1,147 @@
+#include "svgWriter.h"
+#include "outputBuffer.h"
+
+#include <fmt/core.h>
+
+namespace {
+
+    // pixel size of one layout slot and of one level
+    constexpr double SlotWidth = 160.0;
+    constexpr double LevelHeight = 90.0;
+    constexpr double NodeWidth = 140.0;
+    constexpr double NodeHeight = 40.0;
+    constexpr double Margin = 20.0;
+
+    constexpr std::size_t MaxLabelLength = 22;
+
+    void writeEscaped(fbxViz::OutputBuffer& out, std::string_view text)
+    {
+        for (char c : text) {
+            switch (c) {
+            case '&': out.write("&amp;"); break;
+            case '<': out.write("&lt;"); break;
+            case '>': out.write("&gt;"); break;
+            case '"': out.write("&quot;"); break;
+            default: out.put(c); break;
+            }
+        }
+    }
+
+    void writeLabel(fbxViz::OutputBuffer& out, std::string_view text)
+    {
+        if (text.size() <= MaxLabelLength) {
+            writeEscaped(out, text);
+        } else {
+            writeEscaped(out, text.substr(0, MaxLabelLength - 3));
+            out.write("...");
+        }
+    }
+
+    struct Position
+    {
+        double x;
+        double y;
+    };
+
+    Position position(const fbxViz::TreeLayout& layout, fbxViz::NodeId id)
+    {
+        return { Margin + NodeWidth / 2.0 + (layout.x[id] - layout.minX) * SlotWidth,
+                 Margin + NodeHeight / 2.0 + layout.depth[id] * LevelHeight };
+    }
+
+    void writeShape(fbxViz::OutputBuffer& out, std::string_view type, Position p)
+    {
+        constexpr double HalfWidth = NodeWidth / 2.0;
+        constexpr double HalfHeight = NodeHeight / 2.0;
+
+        // special case ( root )
+        if (type.empty()) {
+            out.format("<rect x=\"{:.1f}\" y=\"{:.1f}\" width=\"{}\" height=\"{}\"/>\n",
+                       p.x - HalfWidth, p.y - HalfHeight, NodeWidth, NodeHeight);
+        } else if (type == "mesh") {
+            out.format("<polygon points=\"{0:.1f},{1:.1f} {2:.1f},{3:.1f} {0:.1f},{4:.1f} {5:.1f},{3:.1f}\"/>\n",
+                       p.x, p.y - HalfHeight, p.x + HalfWidth, p.y, p.y + HalfHeight, p.x - HalfWidth);
+        } else {
+            out.format("<ellipse cx=\"{:.1f}\" cy=\"{:.1f}\" rx=\"{}\" ry=\"{}\"/>\n",
+                       p.x, p.y, HalfWidth, HalfHeight);
+        }
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+void writeSvg(const DGraph& graph, const TreeLayout& layout, std::string_view fileName)
+{
+    OutputBuffer out(fileName);
+    if (!out.isOpen()) {
+        return;
+    }
+
+    const auto& nodes = graph.getNodes();
+    const double width = 2.0 * Margin + NodeWidth + (layout.maxX - layout.minX) * SlotWidth;
+    const double height = 2.0 * Margin + NodeHeight + layout.maxDepth * LevelHeight;
+
+    out.format("<svg xmlns=\"http://www.w3.org/2000/svg\" width=\"{0:.0f}\" height=\"{1:.0f}\" "
+               "viewBox=\"0 0 {0:.0f} {1:.0f}\" font-family=\"sans-serif\" font-size=\"11\">\n",
+               width, height);
+
+    out.write("<g stroke=\"#000000\" fill=\"none\">\n");
+    for (NodeId src = 0; src < nodes.size(); ++src) {
+        if (!layout.isPlaced(src)) {
+            continue;
+        }
+
+        const auto from = position(layout, src);
+        for (NodeId dest : graph.children(src)) {
+            if (!layout.isPlaced(dest)) {
+                continue;
+            }
+
+            const auto to = position(layout, dest);
+            out.format("<line x1=\"{:.1f}\" y1=\"{:.1f}\" x2=\"{:.1f}\" y2=\"{:.1f}\"{}/>\n",
+                       from.x, from.y + NodeHeight / 2.0, to.x, to.y - NodeHeight / 2.0,
+                       layout.parent[dest] == src ? "" : " stroke-dasharray=\"4 4\"");
+        }
+    }
+    out.write("</g>\n");
+
+    out.write("<g fill=\"#40e0d0\" stroke=\"#000000\">\n");
+    for (NodeId id = 0; id < nodes.size(); ++id) {
+        if (!layout.isPlaced(id)) {
+            continue;
+        }
+
+        const auto& node = nodes[id];
+        if (node.getFillColor().empty()) {
+            out.write("<g><title>");
+        } else {
+            out.format("<g fill=\"{}\"><title>", node.getFillColor());
+        }
+        writeEscaped(out, node.getName());
+        out.write(" (");
+        writeEscaped(out, node.getType());
+        out.write(")</title>\n");
+
+        const auto p = position(layout, id);
+        writeShape(out, node.getType(), p);
+
+        out.format("<text x=\"{0:.1f}\" y=\"{1:.1f}\" text-anchor=\"middle\" fill=\"#000000\" stroke=\"none\">"
+                   "<tspan font-weight=\"bold\">",
+                   p.x, p.y - 2.0);
+        writeLabel(out, node.getName());
+        out.format("</tspan><tspan x=\"{:.1f}\" dy=\"13\">(", p.x);
+        writeLabel(out, node.getType());
+        out.write(")</tspan></text></g>\n");
+    }
+    out.write("</g>\n");
+
+    out.write("</svg>\n");
+    out.close();
+
+    constexpr double MegaByte = 1024.0 * 1024.0;
+    fmt::print("Generated svg to {} successfully!!! ({:.2f} MB, {:.1f} MB/s)\n",
+               out.fileName(), out.bytesWritten() / MegaByte, out.bytesPerSecond() / MegaByte);
+}
+
+} // namespace fbxViz
@@ -0,0 +1,320 @@
+#include "treeLayout.h"
+
+#include <algorithm>
+#include <cassert>
+
+namespace {
+
+    using fbxViz::NodeId;
+    using fbxViz::InvalidNodeId;
+
+    // the graph as an ordered tree with a virtual root above the real roots
+    class TidyTree
+    {
+    public:
+        explicit TidyTree(const fbxViz::DGraph& graph);
+
+        void layout(fbxViz::TreeLayout& result);
+
+    private:
+        static constexpr double Distance = 1.0;
+
+        bool isLeaf(NodeId v) const { return m_childOffsets[v] == m_childOffsets[v + 1]; }
+        NodeId firstChild(NodeId v) const { return m_children[m_childOffsets[v]]; }
+        NodeId lastChild(NodeId v) const { return m_children[m_childOffsets[v + 1] - 1]; }
+        NodeId leftSibling(NodeId v) const;
+        NodeId leftmostSibling(NodeId v) const;
+
+        NodeId nextLeft(NodeId v) const { return isLeaf(v) ? m_thread[v] : firstChild(v); }
+        NodeId nextRight(NodeId v) const { return isLeaf(v) ? m_thread[v] : lastChild(v); }
+
+        void firstWalk(NodeId v);
+        void place(NodeId v);
+        NodeId apportion(NodeId v, NodeId defaultAncestor);
+        void moveSubtree(NodeId wl, NodeId wr, double shift);
+        void executeShifts(NodeId v);
+        void secondWalk(fbxViz::TreeLayout& result);
+
+        std::size_t m_nodeCount;
+        NodeId m_root;
+
+        std::vector<NodeId> m_parent;
+        std::vector<std::uint32_t> m_number;    // index among the siblings
+        std::vector<std::uint32_t> m_childOffsets;
+        std::vector<NodeId> m_children;
+        std::vector<NodeId> m_postOrder;
+
+        std::vector<double> m_prelim;
+        std::vector<double> m_mod;
+        std::vector<double> m_shift;
+        std::vector<double> m_change;
+        std::vector<double> m_midpoint;
+        std::vector<NodeId> m_thread;
+        std::vector<NodeId> m_ancestor;
+    };
+
+    TidyTree::TidyTree(const fbxViz::DGraph& graph)
+        : m_nodeCount(graph.getNodes().size())
+        , m_root(static_cast<NodeId>(graph.getNodes().size()))
+    {
+        const auto count = m_nodeCount + 1;
+
+        std::vector<bool> hasParent(m_nodeCount, false);
+        for (NodeId id = 0; id < m_nodeCount; ++id) {
+            for (NodeId child : graph.children(id)) {
+                hasParent[child] = true;
+            }
+        }
+
+        // pre-order from the virtual root keeps the first parent of every
+        // node, children come out grouped by parent and in order
+        m_parent.assign(count, InvalidNodeId);
+        m_number.assign(count, 0);
+        m_childOffsets.assign(count + 1, 0);
+
+        std::vector<bool> visited(count, false);
+        std::vector<std::vector<NodeId>> treeChildren(count);
+        for (NodeId id = 0; id < m_nodeCount; ++id) {
+            if (!hasParent[id]) {
+                treeChildren[m_root].push_back(id);
+                visited[id] = true;
+                m_parent[id] = m_root;
+            }
+        }
+
+        std::vector<NodeId> stack(treeChildren[m_root].rbegin(), treeChildren[m_root].rend());
+        visited[m_root] = true;
+        while (!stack.empty()) {
+            const auto v = stack.back();
+            stack.pop_back();
+
+            for (NodeId child : graph.children(v)) {
+                if (!visited[child]) {
+                    visited[child] = true;
+                    m_parent[child] = v;
+                    treeChildren[v].push_back(child);
+                }
+            }
+
+            for (auto it = treeChildren[v].rbegin(); it != treeChildren[v].rend(); ++it) {
+                stack.push_back(*it);
+            }
+        }
+
+        for (NodeId v = 0; v < count; ++v) {
+            m_childOffsets[v + 1] = m_childOffsets[v] + static_cast<std::uint32_t>(treeChildren[v].size());
+        }
+        m_children.reserve(m_childOffsets.back());
+        for (NodeId v = 0; v < count; ++v) {
+            for (std::uint32_t i = 0; i < treeChildren[v].size(); ++i) {
+                m_number[treeChildren[v][i]] = i;
+                m_children.push_back(treeChildren[v][i]);
+            }
+        }
+
+        // post-order of the placed nodes, children before their parent
+        std::vector<std::pair<NodeId, std::uint32_t>> walk{ { m_root, m_childOffsets[m_root] } };
+        while (!walk.empty()) {
+            auto& [v, next] = walk.back();
+            if (next < m_childOffsets[v + 1]) {
+                const auto child = m_children[next++];
+                walk.push_back({ child, m_childOffsets[child] });
+            } else {
+                m_postOrder.push_back(v);
+                walk.pop_back();
+            }
+        }
+
+        m_prelim.assign(count, 0.0);
+        m_mod.assign(count, 0.0);
+        m_shift.assign(count, 0.0);
+        m_change.assign(count, 0.0);
+        m_midpoint.assign(count, 0.0);
+        m_thread.assign(count, InvalidNodeId);
+        m_ancestor.resize(count);
+        for (NodeId v = 0; v < count; ++v) {
+            m_ancestor[v] = v;
+        }
+    }
+
+    NodeId TidyTree::leftSibling(NodeId v) const
+    {
+        return m_number[v] > 0 ? m_children[m_childOffsets[m_parent[v]] + m_number[v] - 1] : InvalidNodeId;
+    }
+
+    NodeId TidyTree::leftmostSibling(NodeId v) const
+    {
+        return firstChild(m_parent[v]);
+    }
+
+    // the recursive first walk places a node right after its subtree is
+    // done and before the next sibling's subtree. Nothing in a sibling's
+    // subtree depends on that, so all children are placed once the post
+    // order reaches their parent.
+    void TidyTree::firstWalk(NodeId v)
+    {
+        if (isLeaf(v)) {
+            m_midpoint[v] = 0.0;
+            return;
+        }
+
+        auto defaultAncestor = firstChild(v);
+        for (auto i = m_childOffsets[v]; i < m_childOffsets[v + 1]; ++i) {
+            const auto w = m_children[i];
+            place(w);
+            defaultAncestor = apportion(w, defaultAncestor);
+        }
+
+        executeShifts(v);
+        m_midpoint[v] = (m_prelim[firstChild(v)] + m_prelim[lastChild(v)]) / 2.0;
+    }
+
+    void TidyTree::place(NodeId v)
+    {
+        const auto w = v != m_root ? leftSibling(v) : InvalidNodeId;
+        if (w != InvalidNodeId) {
+            m_prelim[v] = m_prelim[w] + Distance;
+            m_mod[v] = isLeaf(v) ? 0.0 : m_prelim[v] - m_midpoint[v];
+        } else {
+            m_prelim[v] = m_midpoint[v];
+        }
+    }
+
+    NodeId TidyTree::apportion(NodeId v, NodeId defaultAncestor)
+    {
+        const auto w = leftSibling(v);
+        if (w == InvalidNodeId) {
+            return defaultAncestor;
+        }
+
+        // inner and outer contours of the right ( v ) and left subtrees
+        auto vir = v;
+        auto vor = v;
+        auto vil = w;
+        auto vol = leftmostSibling(v);
+        auto sir = m_mod[vir];
+        auto sor = m_mod[vor];
+        auto sil = m_mod[vil];
+        auto sol = m_mod[vol];
+
+        while (nextRight(vil) != InvalidNodeId && nextLeft(vir) != InvalidNodeId) {
+            vil = nextRight(vil);
+            vir = nextLeft(vir);
+            vol = nextLeft(vol);
+            vor = nextRight(vor);
+            m_ancestor[vor] = v;
+
+            const auto shift = (m_prelim[vil] + sil) - (m_prelim[vir] + sir) + Distance;
+            if (shift > 0.0) {
+                const auto ancestor = m_parent[m_ancestor[vil]] == m_parent[v] ? m_ancestor[vil] : defaultAncestor;
+                moveSubtree(ancestor, v, shift);
+                sir += shift;
+                sor += shift;
+            }
+
+            sil += m_mod[vil];
+            sir += m_mod[vir];
+            sol += m_mod[vol];
+            sor += m_mod[vor];
+        }
+
+        if (nextRight(vil) != InvalidNodeId && nextRight(vor) == InvalidNodeId) {
+            m_thread[vor] = nextRight(vil);
+            m_mod[vor] += sil - sor;
+        }
+
+        if (nextLeft(vir) != InvalidNodeId && nextLeft(vol) == InvalidNodeId) {
+            m_thread[vol] = nextLeft(vir);
+            m_mod[vol] += sir - sol;
+            defaultAncestor = v;
+        }
+
+        return defaultAncestor;
+    }
+
+    void TidyTree::moveSubtree(NodeId wl, NodeId wr, double shift)
+    {
+        const double subtrees = static_cast<double>(m_number[wr] - m_number[wl]);
+        m_change[wr] -= shift / subtrees;
+        m_shift[wr] += shift;
+        m_change[wl] += shift / subtrees;
+        m_prelim[wr] += shift;
+        m_mod[wr] += shift;
+    }
+
+    void TidyTree::executeShifts(NodeId v)
+    {
+        double shift = 0.0;
+        double change = 0.0;
+        for (auto i = m_childOffsets[v + 1]; i-- > m_childOffsets[v];) {
+            const auto w = m_children[i];
+            m_prelim[w] += shift;
+            m_mod[w] += shift;
+            change += m_change[w];
+            shift += m_shift[w] + change;
+        }
+    }
+
+    void TidyTree::secondWalk(fbxViz::TreeLayout& result)
+    {
+        struct Entry
+        {
+            NodeId v;
+            double modSum;
+            std::uint32_t depth;
+        };
+
+        // the virtual root is not drawn, its children are at depth 0
+        std::vector<Entry> stack;
+        for (auto i = m_childOffsets[m_root + 1]; i-- > m_childOffsets[m_root];) {
+            stack.push_back({ m_children[i], m_mod[m_root], 0 });
+        }
+
+        bool first = true;
+        while (!stack.empty()) {
+            const auto entry = stack.back();
+            stack.pop_back();
+
+            const auto x = m_prelim[entry.v] + entry.modSum;
+            result.x[entry.v] = x;
+            result.depth[entry.v] = entry.depth;
+            result.parent[entry.v] = m_parent[entry.v] != m_root ? m_parent[entry.v] : InvalidNodeId;
+
+            result.minX = first ? x : std::min(result.minX, x);
+            result.maxX = first ? x : std::max(result.maxX, x);
+            result.maxDepth = std::max(result.maxDepth, entry.depth);
+            first = false;
+
+            for (auto i = m_childOffsets[entry.v + 1]; i-- > m_childOffsets[entry.v];) {
+                stack.push_back({ m_children[i], entry.modSum + m_mod[entry.v], entry.depth + 1 });
+            }
+        }
+    }
+
+    void TidyTree::layout(fbxViz::TreeLayout& result)
+    {
+        for (auto v : m_postOrder) {
+            firstWalk(v);
+        }
+        place(m_root);
+
+        result.x.assign(m_nodeCount, 0.0);
+        result.depth.assign(m_nodeCount, fbxViz::TreeLayout::NotPlaced);
+        result.parent.assign(m_nodeCount, InvalidNodeId);
+        secondWalk(result);
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+TreeLayout computeTreeLayout(const DGraph& graph)
+{
+    assert(graph.isFrozen());
+
+    TreeLayout result;
+    TidyTree(graph).layout(result);
+    return result;
+}
+
+} // namespace fbxViz
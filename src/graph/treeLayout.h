@@ -0,0 +1,61 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "graph.h"
+
+#include <cstdint>
+#include <vector>
+
+namespace fbxViz {
+
+// positions of the nodes of a tree shaped graph, in units of one node slot
+// horizontally and one level vertically
+struct TreeLayout
+{
+    std::vector<double> x;
+    std::vector<std::uint32_t> depth;
+
+    // the edge each node is placed under, InvalidNodeId for roots and for
+    // nodes that are not reachable from a root
+    std::vector<NodeId> parent;
+
+    double minX{0.0};
+    double maxX{0.0};
+    std::uint32_t maxDepth{0};
+
+    bool isPlaced(NodeId id) const { return depth[id] != NotPlaced; }
+
+    static constexpr std::uint32_t NotPlaced = ~std::uint32_t(0);
+};
+
+// tidy tree drawing of Buchheim, Juenger and Leipert, which runs in linear
+// time: parents centered over their children, subtrees as close as possible
+// without overlapping and identical subtrees drawn identically. Nodes without
+// parents are the roots of a forest, a node reachable from more than one
+// parent is placed under the first. Both walks are iterative so deep
+// hierarchies do not exhaust the stack. The graph must be frozen.
+TreeLayout computeTreeLayout(const DGraph& graph);
+
+} // namespace fbxViz
@@ -0,0 +1,95 @@
+#include "hash.h"
+
+#include <algorithm>
+#include <cstring>
+
+namespace {
+
+    constexpr std::uint64_t Prime1 = 0x9e3779b185ebca87ull;
+    constexpr std::uint64_t Prime2 = 0xc2b2ae3d27d4eb4full;
+
+    std::uint64_t rotl(std::uint64_t x, int r)
+    {
+        return (x << r) | (x >> (64 - r));
+    }
+
+    std::uint64_t mix(std::uint64_t x)
+    {
+        x ^= x >> 33;
+        x *= 0xff51afd7ed558ccdull;
+        x ^= x >> 33;
+        x *= 0xc4ceb9fe1a85ec53ull;
+        x ^= x >> 33;
+        return x;
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+ContentHash::ContentHash()
+    : m_lanes{ Prime1 + Prime2, Prime2, 0, 0 - Prime1 }
+{
+}
+
+void ContentHash::update(const void* bytes, std::size_t size)
+{
+    auto data = static_cast<const unsigned char*>(bytes);
+    m_length += size;
+
+    if (m_pendingSize > 0) {
+        const auto take = std::min(size, sizeof(m_pending) - m_pendingSize);
+        std::memcpy(m_pending + m_pendingSize, data, take);
+        m_pendingSize += take;
+        data += take;
+        size -= take;
+        if (m_pendingSize < sizeof(m_pending)) {
+            return;
+        }
+        block(m_pending);
+        m_pendingSize = 0;
+    }
+
+    for (; size >= sizeof(m_pending); data += sizeof(m_pending), size -= sizeof(m_pending)) {
+        block(data);
+    }
+
+    if (size > 0) {
+        std::memcpy(m_pending, data, size);
+    }
+    m_pendingSize = size;
+}
+
+void ContentHash::update(std::string_view str)
+{
+    // the length keeps "ab" + "c" apart from "a" + "bc"
+    updateValue(static_cast<std::uint64_t>(str.size()));
+    update(str.data(), str.size());
+}
+
+std::uint64_t ContentHash::digest() const
+{
+    auto h = rotl(m_lanes[0], 1) + rotl(m_lanes[1], 7) + rotl(m_lanes[2], 12) + rotl(m_lanes[3], 18);
+    h ^= m_length * Prime1;
+    for (std::size_t i = 0; i < m_pendingSize; ++i) {
+        h = rotl(h ^ (m_pending[i] * Prime2), 11) * Prime1;
+    }
+    return mix(h);
+}
+
+void ContentHash::block(const unsigned char* data)
+{
+    for (auto& lane : m_lanes) {
+        std::uint64_t word;
+        std::memcpy(&word, data, sizeof(word));
+        lane = rotl(lane + word * Prime2, 31) * Prime1;
+        data += sizeof(word);
+    }
+}
+
+std::uint64_t hashCombine(std::uint64_t seed, std::uint64_t value)
+{
+    return mix(seed ^ (value + Prime1 + rotl(seed, 6)));
+}
+
+} // namespace fbxViz
@@ -0,0 +1,64 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+
+namespace fbxViz {
+
+// fast 64 bit hash of a byte stream: four independent lanes over 32 byte
+// blocks, in the spirit of xxHash. Not cryptographic, used for cache keys
+// and change detection where collisions are practically never an issue.
+class ContentHash final
+{
+public:
+    ContentHash();
+
+    void update(const void* data, std::size_t size);
+    void update(std::string_view str);
+
+    // trivially copyable values, hashed by their bytes
+    template <typename T>
+    void updateValue(const T& value)
+    {
+        update(&value, sizeof(T));
+    }
+
+    std::uint64_t digest() const;
+
+private:
+    void block(const unsigned char* data);
+
+    std::uint64_t m_lanes[4];
+    unsigned char m_pending[32];
+    std::size_t m_pendingSize{0};
+    std::uint64_t m_length{0};
+};
+
+// order dependent combination of two hashes
+std::uint64_t hashCombine(std::uint64_t seed, std::uint64_t value);
+
+} // namespace fbxViz
@@ -0,0 +1,39 @@
+#include "layerCurves.h"
+#include "curveInfo.h"
+#include "parallel.h"
+
+namespace fbxViz {
+
+LayerCurves::LayerCurves(const AnimLayerIndex& layerIndex, float tolerance, unsigned jobs)
+{
+    const auto curves = layerIndex.curves();
+
+    m_slots.reserve(curves.size());
+    for (std::size_t i = 0; i < curves.size(); ++i) {
+        m_slots.emplace(curves[i], i);
+    }
+
+    // every task only reads its own curve and writes its own slot
+    m_snapshots.resize(curves.size());
+    m_redundancy.resize(curves.size());
+    parallelFor(curves.size(), jobs, [&](std::size_t i) {
+        m_snapshots[i] = extractCurve(curves[i]);
+        m_redundancy[i] = findRedundantKeys(m_snapshots[i], tolerance);
+    });
+
+    for (const auto& redundancy : m_redundancy) {
+        m_total += redundancy;
+    }
+}
+
+const CurveSnapshot& LayerCurves::snapshot(FbxAnimCurve* curve) const
+{
+    return m_snapshots[m_slots.at(curve)];
+}
+
+const KeyRedundancy& LayerCurves::redundancy(FbxAnimCurve* curve) const
+{
+    return m_redundancy[m_slots.at(curve)];
+}
+
+} // namespace fbxViz
@@ -0,0 +1,59 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "animIndex.h"
+#include "curveRedundancy.h"
+#include "curveSnapshot.h"
+
+#include <fbxsdk.h>
+
+#include <unordered_map>
+#include <vector>
+
+namespace fbxViz {
+
+// snapshots and redundant keys of every curve of an animation layer,
+// extracted and analysed up front on the worker pool so the traversal
+// only looks them up
+class LayerCurves final
+{
+public:
+    LayerCurves(const AnimLayerIndex& layerIndex, float tolerance, unsigned jobs);
+
+    // the curve must belong to the layer
+    const CurveSnapshot& snapshot(FbxAnimCurve* curve) const;
+    const KeyRedundancy& redundancy(FbxAnimCurve* curve) const;
+
+    // sum over all curves of the layer
+    const KeyRedundancy& total() const { return m_total; }
+
+private:
+    std::unordered_map<FbxAnimCurve*, std::size_t> m_slots;
+    std::vector<CurveSnapshot> m_snapshots;
+    std::vector<KeyRedundancy> m_redundancy;
+    KeyRedundancy m_total;
+};
+
+} // namespace fbxViz
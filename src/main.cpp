@@ -21,60 +21,220 @@
 // ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
 // (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
 // SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#include "batch.h"
 #include "common.h"
+#include "nodeFilter.h"
+#include "profile.h"
+#include "resultCache.h"
+#include "sceneValidation.h"
 
 #include <fbxsdk.h>
 
 #include <fmt/core.h>
 
+#include <filesystem>
+#include <memory>
+#include <string>
 #include <string_view>
+#include <vector>
 
 namespace {
 
     void usage(std::string_view program) 
     {
-        fmt::print("Usage: {} <input.fbx>\n", program);
+        fmt::print("Usage: {} [options] <input.fbx>...\n"
+                   "       {} --diff <before.fbx> <after.fbx>\n"
+                   "Options:\n"
+                   "  --stream    write DOT files while traversing instead of building the graph first\n"
+                   "  --format=dot|json|graphml|edgelist\n"
+                   "              graph file format: Graphviz ( default ), newline delimited JSON, GraphML\n"
+                   "              or a compact binary edge list ( .dot, .ndjson, .graphml, .edges )\n"
+                   "  --compress=none|gzip|zstd\n"
+                   "              compress the graphs on a background thread while they are written ( .gz, .zst )\n"
+                   "  --jobs=N    worker threads for the parallel passes ( default: one per core )\n"
+                   "  --curve-detail=summary|full|N\n"
+                   "              animation curve labels: statistics only, every key ( default ) or the first N keys\n"
+                   "  --validate=off|fast|full|async\n"
+                   "              scene checks after loading: none, connections and empty layers, also every\n"
+                   "              curve and mesh ( default ) or full checks on a background thread while the\n"
+                   "              graphs are written\n"
+                   "  --diff      compare two fbx files and write the changes to diff.dot\n"
+                   "  --snapshot  also write the graphs as memory mappable binary snapshots ( .fvs )\n"
+                   "  --svg       also draw the scene hierarchy to dag.svg with a built-in tree layout\n"
+                   "  --redundant-keys[=TOL]\n"
+                   "              report animation keys removable within TOL ( default: 0.0001 )\n"
+                   "  --sample[=FPS]\n"
+                   "              evaluate every animation curve FPS times a second ( default: 30 ) and write\n"
+                   "              the values to animstack.samples.csv, one table per animation stack\n"
+                   "  --sample-format=csv|binary\n"
+                   "              table format of --sample, binary writes animstack.samples.bin\n"
+                   "  --motion-bounds[=FPS]\n"
+                   "              evaluate the world transforms FPS times a second ( default: 30 ) and annotate\n"
+                   "              the nodes of dag.dot with the box they move in\n"
+                   "  --mesh-stats\n"
+                   "              annotate dag.dot with the size and estimated GPU memory of the meshes of every\n"
+                   "              subtree and color the nodes from light yellow to red by that memory\n"
+                   "  --profile[=FILE]\n"
+                   "              write per phase times, peak memory and counters as JSON ( default: profile.json )\n"
+                   "  --root=PATH start at the node with this path of names below the scene root, e.g. Rig/Hips\n"
+                   "  --max-depth=N\n"
+                   "              walk at most N levels below the root\n"
+                   "  --types=TYPE,...\n"
+                   "              only emit nodes with these attribute types, e.g. mesh,skeleton\n"
+                   "  --name-regex=REGEX\n"
+                   "              only emit nodes whose name matches REGEX\n"
+                   "  --manifest=FILE\n"
+                   "              process the fbx files listed in FILE, one per line\n"
+                   "  --output-dir=DIR\n"
+                   "              write the DOT files to DIR\n"
+                   "  --cache-dir=DIR\n"
+                   "              reuse the DOT files of unchanged inputs cached in DIR\n"
+                   "  --cache-size=MB\n"
+                   "              evict the oldest cache entries beyond MB ( default: 1024 )\n"
+                   "Several inputs, directories, patterns like 'dir/*.fbx' or a manifest run in batch mode:\n"
+                   "files are processed on --jobs workers and written to <name>.dag.dot and <name>.animstack.dot\n",
+                   program, program);
     }
 
-    bool hasFbxExtension(std::string_view inputFilePath)
+    // --profile writes to profile.json in the output directory by default
+    void writeProfile(const fbxViz::Profile* profile, const fbxViz::Options& options, const std::vector<std::string>& inputFiles)
     {
-        auto len = inputFilePath.length();
-        auto pos = inputFilePath.rfind('.', len);
-
-        if (pos != std::string::npos) {
-            auto ext = inputFilePath.substr(pos + 1 , len - 1);
-            if (ext == "fbx" || ext == "FBX") {
-                return true;
-            } else {
+        if (!profile) {
+            return;
+        }
+
+        const auto fileName = options.profileFile.empty() ? (std::filesystem::path(options.outputDir) / "profile.json").string() : options.profileFile;
+        profile->write(fileName, inputFiles);
+    }
+
+    // loads both scenes with one manager and writes the delta graph
+    bool diffScenes(const fbxViz::Options& options)
+    {
+        for (const auto& inputFile : options.inputFiles) {
+            if (!fbxViz::hasFbxExtension(inputFile)) {
+                fmt::print("Error: no valid fbx file format provided!\n");
                 return false;
             }
         }
 
-        return false;
+        FbxManager* fbxManager {nullptr};
+        FbxScene* beforeScene {nullptr};
+        if (!fbxViz::initialize(fbxManager, beforeScene)) {
+            fmt::print("An error occurred initializing the fbx sdk...\n");
+            fbxViz::destroy(fbxManager);
+            return false;
+        }
+
+        FbxScene* afterScene = FbxScene::Create(fbxManager, "After Scene");
+        // nothing to overlap the checks with, the hashing needs the scenes first
+        const auto validation = options.validation == fbxViz::ValidationMode::Async ? fbxViz::ValidationMode::Full : options.validation;
+        if (!fbxViz::loadScene(fbxManager, beforeScene, options.inputFiles[0], validation) ||
+            !fbxViz::loadScene(fbxManager, afterScene, options.inputFiles[1], validation)) {
+            fmt::print("An error occurred while loading the scenes...\n");
+            fbxViz::destroy(fbxManager);
+            return false;
+        }
+
+        const std::filesystem::path outputDir(options.outputDir);
+        if (!options.outputDir.empty()) {
+            std::error_code ec;
+            std::filesystem::create_directories(outputDir, ec);
+        }
+
+        const auto diffFile = fbxViz::replaceGraphExtension((outputDir / "diff.dot").string(),
+                                                            fmt::format("{}{}", fbxViz::graphFormatExtension(options.format),
+                                                                        fbxViz::compressionExtension(options.compression)));
+        fbxViz::dumpSceneDiffToFile(beforeScene, afterScene, diffFile, options.format);
+
+        fbxViz::destroy(fbxManager);
+        return true;
     }
 } // namespace
 
 int main(int argc, char** argv)
 {
     std::string_view program = argv[0];
-    if (argv[1] == nullptr) {
+
+    fbxViz::Options options;
+    if (!fbxViz::parseOptions(argc, argv, options)) {
+        usage(program);
+        return 1;
+    }
+
+    if (!fbxViz::NodeFilter::validate(options)) {
+        return 1;
+    }
+
+    if (options.inputFiles.empty() && options.manifest.empty()) {
         usage(program);
         fmt::print("Error: no input file provided!\n");
         return 1;
     }
 
-    std::string_view inputFilePath = argv[1];
-    if (!hasFbxExtension(inputFilePath)) {
+    if (options.diff) {
+        return diffScenes(options) ? 0 : 1;
+    }
+
+    std::unique_ptr<fbxViz::Profile> profile;
+    if (options.profile) {
+        profile = std::make_unique<fbxViz::Profile>();
+    }
+
+    if (fbxViz::isBatch(options)) {
+        std::vector<std::string> inputFiles;
+        if (!fbxViz::collectInputFiles(options, inputFiles)) {
+            return 1;
+        }
+
+        if (inputFiles.empty()) {
+            fmt::print("Error: no fbx files found!\n");
+            return 1;
+        }
+
+        const auto failed = fbxViz::runBatch(inputFiles, options, profile.get());
+        writeProfile(profile.get(), options, inputFiles);
+        return failed == 0 ? 0 : 1;
+    }
+
+    std::string_view inputFilePath = options.inputFiles.front();
+    if (!fbxViz::hasFbxExtension(inputFilePath)) {
         fmt::print("Error: no valid fbx file format provided!\n");
         return 1;
     }
 
+    const std::filesystem::path outputDir(options.outputDir);
+    if (!options.outputDir.empty()) {
+        std::error_code ec;
+        std::filesystem::create_directories(outputDir, ec);
+    }
+
+    const auto outputFiles = fbxViz::outputFileNames((outputDir / "dag.dot").string(), (outputDir / "animstack.dot").string(), options);
+
+    // unchanged input, nothing to do for the SDK
+    fbxViz::ResultCache cache(options);
+    std::string cacheKey;
+    if (cache.enabled()) {
+        cacheKey = cache.key(options.inputFiles.front());
+        if (cache.fetch(cacheKey, outputFiles)) {
+            if (profile) {
+                profile->count(fbxViz::Counter::Files);
+                profile->count(fbxViz::Counter::CacheHits);
+                profile->countFiles(outputFiles);
+            }
+            writeProfile(profile.get(), options, options.inputFiles);
+            return 0;
+        }
+    }
+
     FbxManager* fbxManager {nullptr};
     FbxScene* fbxScene {nullptr};
     bool status {false};
 
     // initialize the FBX SDK.
-    status = fbxViz::initialize(fbxManager, fbxScene);
+    {
+        fbxViz::Profile::Scope scope(profile.get(), fbxViz::Phase::Initialize);
+        status = fbxViz::initialize(fbxManager, fbxScene);
+    }
     if (!status) {
         fmt::print("An error occurred initializing the fbx sdk...\n");
         fbxViz::destroy(fbxManager);
@@ -82,21 +242,63 @@ int main(int argc, char** argv)
     }
 
     // load scene
-    status = fbxViz::loadScene(fbxManager, fbxScene, inputFilePath);
+    status = fbxViz::loadScene(fbxManager, fbxScene, inputFilePath, options.validation, profile.get());
     if (!status) {
         fmt::print("An error occurred while loading the scene...\n");
         fbxViz::destroy(fbxManager);
         return 1;
     }
 
-    // dump scene DAG
-    fbxViz::dumpSceneToFile(fbxScene, "dag.dot");
+    // checked while the graphs are dumped
+    std::unique_ptr<fbxViz::BackgroundValidation> validation;
+    if (options.validation == fbxViz::ValidationMode::Async) {
+        validation = std::make_unique<fbxViz::BackgroundValidation>(fbxScene, inputFilePath, profile.get());
+    }
+
+    // flatten the hierarchy once for both dumps
+    std::unique_ptr<fbxViz::FlatScene> flatScene;
+    {
+        fbxViz::Profile::Scope scope(profile.get(), fbxViz::Phase::Flatten);
+        flatScene = std::make_unique<fbxViz::FlatScene>(fbxScene);
+    }
+
+    // resolved once for both dumps, a --root path that does not exist fails
+    // the run before anything is written
+    const auto root = fbxViz::findRootNode(*flatScene, options);
 
-    // dump animation stack
-    fbxViz::dumpAnimStackToFile(fbxScene, "animstack.dot");
+    // dump scene DAG and animation stack
+    const bool dumped = fbxViz::dumpSceneToFile(*flatScene, root, outputFiles[0], options, profile.get())
+                        && fbxViz::dumpAnimStackToFile(*flatScene, root, outputFiles[1], options, profile.get());
+    flatScene.reset();
+
+    status = !validation || validation->wait();
+    validation.reset();
 
     // destroy the FBX SDK.
     fbxViz::destroy(fbxManager);
 
+    if (!dumped) {
+        fmt::print("An error occurred while writing the graphs...\n");
+        writeProfile(profile.get(), options, options.inputFiles);
+        return 1;
+    }
+
+    if (!status) {
+        fmt::print("An error occurred while validating the scene...\n");
+        writeProfile(profile.get(), options, options.inputFiles);
+        return 1;
+    }
+
+    if (cache.enabled()) {
+        cache.store(cacheKey, outputFiles);
+        cache.evict();
+    }
+
+    if (profile) {
+        profile->count(fbxViz::Counter::Files);
+        profile->countFiles(outputFiles);
+    }
+    writeProfile(profile.get(), options, options.inputFiles);
+
     return 0;
 }
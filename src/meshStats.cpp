@@ -0,0 +1,102 @@
+#include "meshStats.h"
+#include "parallel.h"
+
+namespace {
+
+    constexpr std::uint64_t PositionBytes = 3 * sizeof(float);
+    constexpr std::uint64_t NormalBytes = 3 * sizeof(float);
+    constexpr std::uint64_t TangentBytes = 4 * sizeof(float);
+    constexpr std::uint64_t UvBytes = 2 * sizeof(float);
+    constexpr std::uint64_t ColorBytes = 4;
+    constexpr std::uint64_t IndexBytes = sizeof(std::uint32_t);
+
+    constexpr std::uint32_t MeshBit = std::uint32_t(1) << FbxNodeAttribute::eMesh;
+
+} // namespace
+
+namespace fbxViz {
+
+MeshStats& MeshStats::operator+=(const MeshStats& other)
+{
+    meshes += other.meshes;
+    controlPoints += other.controlPoints;
+    polygons += other.polygons;
+    triangles += other.triangles;
+    uvSets += other.uvSets;
+    layerElements += other.layerElements;
+    gpuBytes += other.gpuBytes;
+    return *this;
+}
+
+MeshStats computeMeshStats(FbxMesh* pMesh)
+{
+    MeshStats stats;
+    stats.meshes = 1;
+    stats.controlPoints = static_cast<std::uint64_t>(pMesh->GetControlPointsCount());
+
+    const auto polygonCount = pMesh->GetPolygonCount();
+    stats.polygons = static_cast<std::uint64_t>(polygonCount);
+    for (auto polygon = 0; polygon < polygonCount; ++polygon) {
+        const auto size = pMesh->GetPolygonSize(polygon);
+        if (size >= 3) {
+            stats.triangles += static_cast<std::uint64_t>(size - 2);
+        }
+    }
+
+    const auto normals = pMesh->GetElementNormalCount();
+    const auto tangents = pMesh->GetElementTangentCount();
+    const auto binormals = pMesh->GetElementBinormalCount();
+    const auto colors = pMesh->GetElementVertexColorCount();
+    const auto uvs = pMesh->GetElementUVCount();
+    stats.uvSets = static_cast<std::uint64_t>(uvs);
+    stats.layerElements = static_cast<std::uint64_t>(normals + tangents + binormals + colors + uvs + pMesh->GetElementMaterialCount()
+                                                      + pMesh->GetElementSmoothingCount());
+
+    // the binormal is rebuilt from the normal and the tangent sign
+    std::uint64_t vertexBytes = PositionBytes;
+    vertexBytes += normals > 0 ? NormalBytes : 0;
+    vertexBytes += tangents > 0 ? TangentBytes : 0;
+    vertexBytes += static_cast<std::uint64_t>(uvs) * UvBytes;
+    vertexBytes += static_cast<std::uint64_t>(colors) * ColorBytes;
+
+    const auto vertices = static_cast<std::uint64_t>(pMesh->GetPolygonVertexCount());
+    stats.gpuBytes = vertices * vertexBytes + stats.triangles * 3 * IndexBytes;
+    return stats;
+}
+
+SceneMeshStats computeSceneMeshStats(const FlatScene& scene, unsigned jobs)
+{
+    SceneMeshStats stats;
+    stats.own.resize(scene.size());
+
+    std::vector<FlatScene::Index> meshNodes;
+    for (FlatScene::Index i = 0; i < scene.size(); ++i) {
+        if (scene.typeMask(i) & MeshBit) {
+            meshNodes.push_back(i);
+        }
+    }
+
+    // every task writes the slot of its own node
+    parallelFor(meshNodes.size(), jobs, [&](std::size_t task) {
+        const auto index = meshNodes[task];
+        FbxNode* pNode = scene.node(index);
+        for (auto i = 0; i < pNode->GetNodeAttributeCount(); ++i) {
+            FbxNodeAttribute* attribute = pNode->GetNodeAttributeByIndex(i);
+            if (attribute->GetAttributeType() == FbxNodeAttribute::eMesh) {
+                stats.own[index] += computeMeshStats(static_cast<FbxMesh*>(attribute));
+            }
+        }
+    });
+
+    stats.subtree = stats.own;
+    for (auto i = scene.size(); i-- > 1;) {
+        const auto parent = scene.parent(static_cast<FlatScene::Index>(i));
+        if (parent != FlatScene::None) {
+            stats.subtree[parent] += stats.subtree[i];
+        }
+    }
+
+    return stats;
+}
+
+} // namespace fbxViz
@@ -0,0 +1,67 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "flatScene.h"
+
+#include <fbxsdk.h>
+
+#include <cstdint>
+#include <vector>
+
+namespace fbxViz {
+
+// what a mesh costs to load and draw
+struct MeshStats
+{
+    std::uint64_t meshes{0};
+    std::uint64_t controlPoints{0};
+    std::uint64_t polygons{0};
+    std::uint64_t triangles{0};         // after fan triangulation, smaller polygons are skipped
+    std::uint64_t uvSets{0};
+    std::uint64_t layerElements{0};     // normals, tangents, binormals, colors, UVs, materials and smoothing
+    std::uint64_t gpuBytes{0};          // estimated vertex and index buffers
+
+    MeshStats& operator+=(const MeshStats& other);
+};
+
+// reads the counts of one mesh. The GPU estimate assumes one vertex per
+// polygon corner, the size before identical corners are welded, with a
+// position, a normal and a tangent when the mesh has them, one float2 per UV
+// set and one RGBA8 color per color set, and 32 bit triangle indices.
+MeshStats computeMeshStats(FbxMesh* pMesh);
+
+// the statistics of every node of a flattened scene, by FlatScene index
+struct SceneMeshStats
+{
+    std::vector<MeshStats> own;         // the meshes attached to the node
+    std::vector<MeshStats> subtree;     // the node and all its descendants
+};
+
+// the meshes are read on `jobs` workers, the subtree totals are then summed
+// bottom-up in reverse pre-order, every child before its parent. An
+// instanced mesh counts once for every node it is attached to.
+SceneMeshStats computeSceneMeshStats(const FlatScene& scene, unsigned jobs);
+
+} // namespace fbxViz
@@ -0,0 +1,114 @@
+#include "nodeFilter.h"
+
+#include <fmt/core.h>
+
+#include <string_view>
+
+namespace {
+
+    constexpr auto FirstType = FbxNodeAttribute::eUnknown;
+    constexpr auto LastType = FbxNodeAttribute::eLine;
+
+    // bits of the attribute types labelled name, "marker" covers two types
+    std::uint32_t typeBits(std::string_view name)
+    {
+        std::uint32_t bits = 0;
+        for (int type = FirstType; type <= LastType; ++type) {
+            if (name == fbxViz::nodeTypeName(fbxViz::nodeType(static_cast<FbxNodeAttribute::EType>(type)))) {
+                bits |= std::uint32_t(1) << type;
+            }
+        }
+
+        return bits;
+    }
+
+    std::vector<std::string> splitPath(std::string_view path)
+    {
+        std::vector<std::string> names;
+        std::size_t pos = 0;
+        while (pos <= path.size()) {
+            auto end = path.find('/', pos);
+            if (end == std::string_view::npos) {
+                end = path.size();
+            }
+
+            if (end > pos) {
+                names.emplace_back(path.substr(pos, end - pos));
+            }
+            pos = end + 1;
+        }
+
+        return names;
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+NodeFilter::NodeFilter(const Options& options)
+    : m_rootPath(splitPath(options.root))
+    , m_maxDepth(options.maxDepth)
+{
+    for (const auto& type : options.types) {
+        m_typeMask |= typeBits(type);
+    }
+
+    if (!options.nameRegex.empty()) {
+        m_nameRegex.emplace(options.nameRegex, std::regex::ECMAScript | std::regex::optimize);
+    }
+}
+
+bool NodeFilter::validate(const Options& options)
+{
+    for (const auto& type : options.types) {
+        if (typeBits(type) == 0) {
+            fmt::print("Error: unknown node type {}!\n", type);
+            return false;
+        }
+    }
+
+    if (!options.nameRegex.empty()) {
+        try {
+            std::regex regex(options.nameRegex);
+        } catch (const std::regex_error& error) {
+            fmt::print("Error: invalid --name-regex {} ( {} )!\n", options.nameRegex, error.what());
+            return false;
+        }
+    }
+
+    return true;
+}
+
+FlatScene::Index NodeFilter::findRoot(const FlatScene& scene) const
+{
+    FlatScene::Index node = scene.empty() ? FlatScene::None : 0;
+    for (const auto& name : m_rootPath) {
+        if (node == FlatScene::None) {
+            break;
+        }
+
+        auto child = scene.firstChild(node);
+        while (child != FlatScene::None && scene.name(child) != name) {
+            child = scene.nextSibling(child);
+        }
+        node = child;
+    }
+
+    return node;
+}
+
+bool NodeFilter::matches(const FlatScene& scene, FlatScene::Index node) const
+{
+    if (m_typeMask != 0 && (scene.typeMask(node) & m_typeMask) == 0) {
+        return false;
+    }
+
+    if (m_nameRegex) {
+        const auto name = scene.name(node);
+        return std::regex_search(name.begin(), name.end(), *m_nameRegex);
+    }
+
+    return true;
+}
+
+} // namespace fbxViz
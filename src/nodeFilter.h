@@ -0,0 +1,73 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "flatScene.h"
+#include "nodeType.h"
+#include "options.h"
+
+#include <fbxsdk.h>
+
+#include <cstdint>
+#include <optional>
+#include <regex>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fbxViz {
+
+// --root, --max-depth, --types and --name-regex, applied while the scene is
+// walked. Branches below the depth limit are never entered. Nodes the type or
+// name test rejects are walked through without being emitted, so only their
+// matching descendants cost a graph node.
+class NodeFilter final
+{
+public:
+    // expects options that passed validate()
+    explicit NodeFilter(const Options& options);
+
+    // prints an error for an unknown --types name or a bad --name-regex
+    static bool validate(const Options& options);
+
+    // the node at the --root path below the scene root, the scene root
+    // without one and FlatScene::None when no node has that path
+    FlatScene::Index findRoot(const FlatScene& scene) const;
+
+    // whether the children of a node at this depth below the root are walked
+    bool descend(unsigned depth) const { return depth < m_maxDepth; }
+
+    // type and name test
+    bool matches(const FlatScene& scene, FlatScene::Index node) const;
+
+private:
+    std::vector<std::string> m_rootPath;
+    unsigned m_maxDepth;
+
+    // one bit per FbxNodeAttribute::EType, 0 accepts every type
+    std::uint32_t m_typeMask{0};
+    std::optional<std::regex> m_nameRegex;
+};
+
+} // namespace fbxViz
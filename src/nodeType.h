@@ -0,0 +1,126 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <fbxsdk.h>
+
+#include <cstdint>
+#include <iterator>
+#include <string_view>
+
+namespace fbxViz {
+
+// the type shown on a graph node. The labels of the FBX node attribute types
+// come first, some attribute types share one, followed by the nodes the
+// animation stack traversal adds.
+enum class NodeType : std::uint8_t
+{
+    Unidentified,
+    Null,
+    Marker,
+    Skeleton,
+    Mesh,
+    Nurbs,
+    Patch,
+    Camera,
+    Stereo,
+    CameraSwitcher,
+    Light,
+    OpticalReference,
+    NurbsCurve,
+    TrimNurbsSurface,
+    Boundary,
+    NurbsSurface,
+    Shape,
+    LodGroup,
+    SubDiv,
+    Unknown,
+    AnimationStack,
+    AnimationLayer,
+    Property,
+    Count
+};
+
+constexpr std::string_view NodeTypeNames[] = {
+    "unidentified",
+    "null",
+    "marker",
+    "skeleton",
+    "mesh",
+    "nurbs",
+    "patch",
+    "camera",
+    "stereo",
+    "camera switcher",
+    "light",
+    "optical reference",
+    "nurbs curve",
+    "trim nurbs surface",
+    "boundary",
+    "nurbs surface",
+    "shape",
+    "lodgroup",
+    "subdiv",
+    "unknown",
+    "AnimationStack",
+    "AnimationLayer",
+    "property",
+};
+
+static_assert(std::size(NodeTypeNames) == static_cast<std::size_t>(NodeType::Count), "one name per node type");
+
+// e.g. "mesh" or "skeleton"
+constexpr std::string_view nodeTypeName(NodeType type)
+{
+    return NodeTypeNames[static_cast<std::size_t>(type)];
+}
+
+constexpr NodeType nodeType(FbxNodeAttribute::EType type)
+{
+    switch(type) {
+        case FbxNodeAttribute::eUnknown: return NodeType::Unidentified;
+        case FbxNodeAttribute::eNull: return NodeType::Null;
+        case FbxNodeAttribute::eMarker: return NodeType::Marker;
+        case FbxNodeAttribute::eSkeleton: return NodeType::Skeleton;
+        case FbxNodeAttribute::eMesh: return NodeType::Mesh;
+        case FbxNodeAttribute::eNurbs: return NodeType::Nurbs;
+        case FbxNodeAttribute::ePatch: return NodeType::Patch;
+        case FbxNodeAttribute::eCamera: return NodeType::Camera;
+        case FbxNodeAttribute::eCameraStereo: return NodeType::Stereo;
+        case FbxNodeAttribute::eCameraSwitcher: return NodeType::CameraSwitcher;
+        case FbxNodeAttribute::eLight: return NodeType::Light;
+        case FbxNodeAttribute::eOpticalReference: return NodeType::OpticalReference;
+        case FbxNodeAttribute::eOpticalMarker: return NodeType::Marker;
+        case FbxNodeAttribute::eNurbsCurve: return NodeType::NurbsCurve;
+        case FbxNodeAttribute::eTrimNurbsSurface: return NodeType::TrimNurbsSurface;
+        case FbxNodeAttribute::eBoundary: return NodeType::Boundary;
+        case FbxNodeAttribute::eNurbsSurface: return NodeType::NurbsSurface;
+        case FbxNodeAttribute::eShape: return NodeType::Shape;
+        case FbxNodeAttribute::eLODGroup: return NodeType::LodGroup;
+        case FbxNodeAttribute::eSubDiv: return NodeType::SubDiv;
+        default: return NodeType::Unknown;
+    }
+}
+
+} // namespace fbxViz
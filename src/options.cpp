@@ -0,0 +1,289 @@
+#include "options.h"
+
+#include <fmt/core.h>
+
+#include <cstdlib>
+#include <string_view>
+
+namespace {
+
+    // matches "--name=value" and returns the value
+    bool matchValue(std::string_view arg, std::string_view name, std::string_view& value)
+    {
+        if (arg.size() > name.size() && arg.substr(0, name.size()) == name && arg[name.size()] == '=') {
+            value = arg.substr(name.size() + 1);
+            return true;
+        }
+
+        return false;
+    }
+
+    bool parseUnsigned(std::string_view name, std::string_view value, unsigned& result)
+    {
+        std::string str(value);
+        char* end = nullptr;
+        auto number = std::strtoul(str.c_str(), &end, 10);
+        if (str.empty() || *end != '\0') {
+            fmt::print("Error: {} expects a number, got {}!\n", name, value);
+            return false;
+        }
+
+        result = static_cast<unsigned>(number);
+        return true;
+    }
+
+    bool parseFloat(std::string_view name, std::string_view value, float& result)
+    {
+        std::string str(value);
+        char* end = nullptr;
+        auto number = std::strtof(str.c_str(), &end);
+        if (str.empty() || *end != '\0' || number < 0.0f) {
+            fmt::print("Error: {} expects a positive number, got {}!\n", name, value);
+            return false;
+        }
+
+        result = number;
+        return true;
+    }
+
+    // "mesh,skeleton"
+    std::vector<std::string> splitList(std::string_view value)
+    {
+        std::vector<std::string> items;
+        std::size_t pos = 0;
+        while (pos <= value.size()) {
+            auto end = value.find(',', pos);
+            if (end == std::string_view::npos) {
+                end = value.size();
+            }
+
+            if (end > pos) {
+                items.emplace_back(value.substr(pos, end - pos));
+            }
+            pos = end + 1;
+        }
+
+        return items;
+    }
+
+    bool parseValidationMode(std::string_view value, fbxViz::ValidationMode& mode)
+    {
+        if (value == "off") {
+            mode = fbxViz::ValidationMode::Off;
+        } else if (value == "fast") {
+            mode = fbxViz::ValidationMode::Fast;
+        } else if (value == "full") {
+            mode = fbxViz::ValidationMode::Full;
+        } else if (value == "async") {
+            mode = fbxViz::ValidationMode::Async;
+        } else {
+            fmt::print("Error: --validate expects off, fast, full or async, got {}!\n", value);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool parseGraphFormat(std::string_view value, fbxViz::GraphFormat& format)
+    {
+        if (value == "dot") {
+            format = fbxViz::GraphFormat::Dot;
+        } else if (value == "json") {
+            format = fbxViz::GraphFormat::Json;
+        } else if (value == "graphml") {
+            format = fbxViz::GraphFormat::GraphMl;
+        } else if (value == "edgelist") {
+            format = fbxViz::GraphFormat::EdgeList;
+        } else {
+            fmt::print("Error: --format expects dot, json, graphml or edgelist, got {}!\n", value);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool parseCompression(std::string_view value, fbxViz::Compression& compression)
+    {
+        if (value == "none") {
+            compression = fbxViz::Compression::None;
+        } else if (value == "gzip") {
+            compression = fbxViz::Compression::Gzip;
+        } else if (value == "zstd") {
+            compression = fbxViz::Compression::Zstd;
+        } else {
+            fmt::print("Error: --compress expects none, gzip or zstd, got {}!\n", value);
+            return false;
+        }
+
+        if (!fbxViz::isCompressionAvailable(compression)) {
+            fmt::print("Error: FbxViz was built without {} support!\n", value);
+            return false;
+        }
+
+        return true;
+    }
+
+    bool parseSampleFormat(std::string_view value, fbxViz::SampleFormat& format)
+    {
+        if (value == "csv") {
+            format = fbxViz::SampleFormat::Csv;
+        } else if (value == "binary") {
+            format = fbxViz::SampleFormat::Binary;
+        } else {
+            fmt::print("Error: --sample-format expects csv or binary, got {}!\n", value);
+            return false;
+        }
+
+        return true;
+    }
+
+    // "summary", "full" or a maximum number of key rows
+    bool parseCurveDetail(std::string_view value, fbxViz::CurveDetail& detail)
+    {
+        if (value == "summary") {
+            detail.mode = fbxViz::CurveDetail::Mode::Summary;
+            return true;
+        }
+
+        if (value == "full") {
+            detail.mode = fbxViz::CurveDetail::Mode::Full;
+            return true;
+        }
+
+        unsigned rows = 0;
+        if (!parseUnsigned("--curve-detail", value, rows)) {
+            return false;
+        }
+
+        detail.mode = fbxViz::CurveDetail::Mode::Rows;
+        detail.maxRows = rows;
+        return true;
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+bool parseOptions(int argc, char** argv, Options& options)
+{
+    for (auto i = 1; i < argc; ++i) {
+        std::string_view arg = argv[i];
+        std::string_view value;
+
+        if (arg == "--stream") {
+            options.streaming = true;
+        } else if (matchValue(arg, "--format", value)) {
+            if (!parseGraphFormat(value, options.format)) {
+                return false;
+            }
+        } else if (matchValue(arg, "--compress", value)) {
+            if (!parseCompression(value, options.compression)) {
+                return false;
+            }
+        } else if (matchValue(arg, "--jobs", value)) {
+            if (!parseUnsigned("--jobs", value, options.jobs)) {
+                return false;
+            }
+        } else if (matchValue(arg, "--curve-detail", value)) {
+            if (!parseCurveDetail(value, options.curveDetail)) {
+                return false;
+            }
+        } else if (matchValue(arg, "--validate", value)) {
+            if (!parseValidationMode(value, options.validation)) {
+                return false;
+            }
+        } else if (arg == "--diff") {
+            options.diff = true;
+        } else if (arg == "--snapshot") {
+            options.snapshot = true;
+        } else if (arg == "--svg") {
+            options.svg = true;
+        } else if (arg == "--redundant-keys") {
+            options.redundantKeys = true;
+        } else if (matchValue(arg, "--redundant-keys", value)) {
+            options.redundantKeys = true;
+            if (!parseFloat("--redundant-keys", value, options.redundantKeyTolerance)) {
+                return false;
+            }
+        } else if (arg == "--sample") {
+            options.sample = true;
+        } else if (matchValue(arg, "--sample", value)) {
+            options.sample = true;
+            if (!parseFloat("--sample", value, options.sampleRate)) {
+                return false;
+            }
+            if (options.sampleRate <= 0.0f) {
+                fmt::print("Error: --sample expects a frame rate above 0, got {}!\n", value);
+                return false;
+            }
+        } else if (matchValue(arg, "--sample-format", value)) {
+            if (!parseSampleFormat(value, options.sampleFormat)) {
+                return false;
+            }
+        } else if (arg == "--motion-bounds") {
+            options.motionBounds = true;
+        } else if (matchValue(arg, "--motion-bounds", value)) {
+            options.motionBounds = true;
+            if (!parseFloat("--motion-bounds", value, options.motionBoundsRate)) {
+                return false;
+            }
+            if (options.motionBoundsRate <= 0.0f) {
+                fmt::print("Error: --motion-bounds expects a frame rate above 0, got {}!\n", value);
+                return false;
+            }
+        } else if (arg == "--mesh-stats") {
+            options.meshStats = true;
+        } else if (arg == "--profile") {
+            options.profile = true;
+        } else if (matchValue(arg, "--profile", value)) {
+            options.profile = true;
+            options.profileFile = value;
+        } else if (matchValue(arg, "--root", value)) {
+            options.root = value;
+        } else if (matchValue(arg, "--max-depth", value)) {
+            if (!parseUnsigned("--max-depth", value, options.maxDepth)) {
+                return false;
+            }
+        } else if (matchValue(arg, "--types", value)) {
+            options.types = splitList(value);
+        } else if (matchValue(arg, "--name-regex", value)) {
+            options.nameRegex = value;
+        } else if (matchValue(arg, "--manifest", value)) {
+            options.manifest = value;
+        } else if (matchValue(arg, "--output-dir", value)) {
+            options.outputDir = value;
+        } else if (matchValue(arg, "--cache-dir", value)) {
+            options.cacheDir = value;
+        } else if (matchValue(arg, "--cache-size", value)) {
+            unsigned megaBytes = 0;
+            if (!parseUnsigned("--cache-size", value, megaBytes)) {
+                return false;
+            }
+            options.cacheSize = std::uintmax_t(megaBytes) << 20;
+        } else if (arg.substr(0, 2) == "--") {
+            fmt::print("Error: unknown option {}!\n", arg);
+            return false;
+        } else {
+            options.inputFiles.emplace_back(arg);
+        }
+    }
+
+    if (options.diff && (options.inputFiles.size() != 2 || !options.manifest.empty())) {
+        fmt::print("Error: --diff expects exactly two fbx files!\n");
+        return false;
+    }
+
+    if (options.snapshot && options.streaming) {
+        fmt::print("Error: --snapshot needs the in-memory graph and can not be used with --stream!\n");
+        return false;
+    }
+
+    if (options.svg && options.streaming) {
+        fmt::print("Error: --svg needs the in-memory graph and can not be used with --stream!\n");
+        return false;
+    }
+
+    return true;
+}
+
+} // namespace fbxViz
@@ -0,0 +1,144 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "graph/compression.h"
+#include "graph/graphFormat.h"
+
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fbxViz {
+
+// how much of every animation curve ends up in its node label
+struct CurveDetail
+{
+    enum class Mode
+    {
+        Full,       // one row per key
+        Summary,    // key count, time span, value range and interpolation histogram
+        Rows        // the first maxRows keys
+    };
+
+    Mode mode{Mode::Full};
+    std::size_t maxRows{0};
+};
+
+// FbxSceneCheckUtility checks run on every loaded scene
+enum class ValidationMode
+{
+    Off,
+    Fast,       // connection cycles, empty animation layers and other data
+    Full,       // also every curve and every mesh
+    Async       // full, on a background thread while the graphs are built
+};
+
+// --sample-format, the layout of the sampled curve table
+enum class SampleFormat
+{
+    Csv,
+    Binary      // header, channel names and rows of floats, see curveSampler.h
+};
+
+struct Options
+{
+    // fbx files, directories or file name patterns with '*' and '?'
+    std::vector<std::string> inputFiles;
+
+    // text file listing one input per line
+    std::string manifest;
+
+    // where the DOT files go, the working directory by default
+    std::string outputDir;
+
+    // DOT files of unchanged inputs are served from here when set
+    std::string cacheDir;
+    std::uintmax_t cacheSize{std::uintmax_t(1) << 30};
+
+    // write DOT statements while the scene is traversed instead of
+    // building the whole graph in memory first
+    bool streaming{false};
+
+    // file format of the written graphs
+    GraphFormat format{GraphFormat::Dot};
+
+    // compress the graphs while they are written, adds .gz or .zst to their names
+    Compression compression{Compression::None};
+
+    // worker threads for the parallel passes, 0 means one per hardware thread
+    unsigned jobs{0};
+
+    CurveDetail curveDetail;
+
+    ValidationMode validation{ValidationMode::Full};
+
+    // compare the two input files instead of dumping them
+    bool diff{false};
+
+    // also write the graphs as memory mappable binary snapshots
+    bool snapshot{false};
+
+    // also draw the scene hierarchy to SVG without going through Graphviz
+    bool svg{false};
+
+    // report animation keys that can be removed within the tolerance
+    bool redundantKeys{false};
+    float redundantKeyTolerance{1e-4f};
+
+    // sample every animation curve at sampleRate frames per second over the
+    // time span of the animation stacks and write the values as a table
+    bool sample{false};
+    float sampleRate{30.0f};
+    SampleFormat sampleFormat{SampleFormat::Csv};
+
+    // evaluate the world transforms of the nodes at motionBoundsRate frames
+    // per second and annotate the scene DAG with the box each node moves in
+    bool motionBounds{false};
+    float motionBoundsRate{30.0f};
+
+    // count the control points, polygons, triangles, UV sets and layer
+    // elements of every mesh, estimate its GPU memory and color the scene DAG
+    // by the cost of each subtree
+    bool meshStats{false};
+
+    // write the phase times and counters of the run as JSON, to profileFile
+    // or profile.json in the output directory
+    bool profile{false};
+    std::string profileFile;
+
+    // traversal filters: node path below the scene root to start from, how
+    // many levels below it to walk ( unlimited by default ), the attribute
+    // types and the name pattern of the nodes to emit
+    std::string root;
+    unsigned maxDepth{~0u};
+    std::vector<std::string> types;
+    std::string nameRegex;
+};
+
+// parses the command line, prints an error and returns false on bad input
+bool parseOptions(int argc, char** argv, Options& options);
+
+} // namespace fbxViz
@@ -0,0 +1,50 @@
+#include "parallel.h"
+
+#include <algorithm>
+#include <atomic>
+#include <thread>
+#include <vector>
+
+namespace fbxViz {
+
+unsigned workerCount(unsigned requested)
+{
+    if (requested > 0) {
+        return requested;
+    }
+
+    return std::max(1u, std::thread::hardware_concurrency());
+}
+
+void parallelFor(std::size_t count, unsigned workers, const std::function<void(std::size_t)>& task)
+{
+    workers = static_cast<unsigned>(std::min<std::size_t>(workerCount(workers), count));
+
+    if (workers <= 1) {
+        for (std::size_t i = 0; i < count; ++i) {
+            task(i);
+        }
+        return;
+    }
+
+    std::atomic<std::size_t> next{0};
+    auto worker = [&]() {
+        for (auto i = next++; i < count; i = next++) {
+            task(i);
+        }
+    };
+
+    // the calling thread is one of the workers
+    std::vector<std::thread> threads;
+    threads.reserve(workers - 1);
+    for (unsigned i = 1; i < workers; ++i) {
+        threads.emplace_back(worker);
+    }
+    worker();
+
+    for (auto& thread : threads) {
+        thread.join();
+    }
+}
+
+} // namespace fbxViz
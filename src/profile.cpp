@@ -0,0 +1,277 @@
+#include "profile.h"
+
+#include "graph/outputBuffer.h"
+
+#include <fmt/format.h>
+
+#include <filesystem>
+#include <iterator>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+    #include <psapi.h>
+#else
+    #include <sys/resource.h>
+    #include <time.h>
+#endif
+
+namespace {
+
+    constexpr const char* PhaseNames[] = {
+        "initialize",
+        "import",
+        "validate",
+        "flatten",
+        "dagTraversal",
+        "animStackTraversal",
+        "serialize",
+        "sample",
+        "motionBounds",
+        "meshStats"
+    };
+
+    constexpr const char* CounterNames[] = {
+        "files",
+        "cacheHits",
+        "nodes",
+        "edges",
+        "curves",
+        "keys",
+        "bytesWritten"
+    };
+
+    static_assert(std::size(PhaseNames) == static_cast<std::size_t>(fbxViz::Phase::Count), "one name per phase");
+    static_assert(std::size(CounterNames) == static_cast<std::size_t>(fbxViz::Counter::Count), "one name per counter");
+
+    std::uint64_t toNanoseconds(double seconds)
+    {
+        return seconds > 0.0 ? static_cast<std::uint64_t>(seconds * 1e9) : 0;
+    }
+
+#if defined(_WIN32)
+
+    std::uint64_t peakResidentBytes()
+    {
+        PROCESS_MEMORY_COUNTERS counters;
+        if (!GetProcessMemoryInfo(GetCurrentProcess(), &counters, sizeof(counters))) {
+            return 0;
+        }
+
+        return counters.PeakWorkingSetSize;
+    }
+
+#else
+
+    std::uint64_t peakResidentBytes()
+    {
+        rusage usage;
+        if (getrusage(RUSAGE_SELF, &usage) != 0) {
+            return 0;
+        }
+
+    #if defined(__APPLE__)
+        return static_cast<std::uint64_t>(usage.ru_maxrss);
+    #else
+        // kilobytes on Linux
+        return static_cast<std::uint64_t>(usage.ru_maxrss) * 1024;
+    #endif
+    }
+
+#endif
+
+    void writeJsonString(std::string& out, std::string_view text)
+    {
+        out.push_back('"');
+        for (char c : text) {
+            if (c == '"' || c == '\\') {
+                out.push_back('\\');
+                out.push_back(c);
+            } else if (static_cast<unsigned char>(c) < 0x20) {
+                fmt::format_to(std::back_inserter(out), "\\u{:04x}", static_cast<unsigned>(c));
+            } else {
+                out.push_back(c);
+            }
+        }
+        out.push_back('"');
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+std::string_view phaseName(Phase phase)
+{
+    return PhaseNames[static_cast<std::size_t>(phase)];
+}
+
+Profile::Profile()
+    : m_wallStart(std::chrono::steady_clock::now())
+    , m_cpuStart(processCpuSeconds())
+{
+}
+
+Profile::Scope::Scope(Profile* profile, Phase phase, bool measureCpu)
+    : m_profile(profile)
+    , m_phase(phase)
+    , m_measureCpu(measureCpu)
+{
+    if (m_profile) {
+        m_wallStart = std::chrono::steady_clock::now();
+        m_cpuStart = m_measureCpu ? threadCpuSeconds() : 0.0;
+    }
+}
+
+Profile::Scope::~Scope()
+{
+    if (m_profile) {
+        const auto wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_wallStart).count();
+        m_profile->addPhase(m_phase, wall, m_measureCpu ? threadCpuSeconds() - m_cpuStart : -1.0);
+    }
+}
+
+void Profile::addPhase(Phase phase, double wallSeconds, double cpuSeconds)
+{
+    const auto index = static_cast<std::size_t>(phase);
+    m_wallNanoseconds[index] += toNanoseconds(wallSeconds);
+    ++m_phaseCalls[index];
+
+    if (cpuSeconds >= 0.0) {
+        m_cpuNanoseconds[index] += toNanoseconds(cpuSeconds);
+        ++m_cpuCalls[index];
+    }
+}
+
+void Profile::count(Counter counter, std::uint64_t value)
+{
+    m_counters[static_cast<std::size_t>(counter)] += value;
+}
+
+void Profile::countFiles(const std::vector<std::string>& fileNames)
+{
+    for (const auto& fileName : fileNames) {
+        std::error_code ec;
+        const auto size = std::filesystem::file_size(fileName, ec);
+        if (!ec) {
+            count(Counter::BytesWritten, size);
+        }
+    }
+}
+
+double Profile::wallSeconds(Phase phase) const
+{
+    return m_wallNanoseconds[static_cast<std::size_t>(phase)] * 1e-9;
+}
+
+double Profile::cpuSeconds(Phase phase) const
+{
+    return m_cpuNanoseconds[static_cast<std::size_t>(phase)] * 1e-9;
+}
+
+std::uint64_t Profile::counter(Counter counter) const
+{
+    return m_counters[static_cast<std::size_t>(counter)];
+}
+
+bool Profile::write(std::string_view fileName, const std::vector<std::string>& inputFiles) const
+{
+    const auto wall = std::chrono::duration<double>(std::chrono::steady_clock::now() - m_wallStart).count();
+    const auto cpu = processCpuSeconds() - m_cpuStart;
+
+    std::string json;
+    json.append("{\n  \"inputs\": [");
+    for (std::size_t i = 0; i < inputFiles.size(); ++i) {
+        json.append(i == 0 ? "" : ", ");
+        writeJsonString(json, inputFiles[i]);
+    }
+    fmt::format_to(std::back_inserter(json), "],\n"
+                   "  \"wallSeconds\": {:.6f},\n"
+                   "  \"cpuSeconds\": {:.6f},\n"
+                   "  \"peakResidentBytes\": {},\n"
+                   "  \"phases\": {{\n",
+                   wall, cpu, peakResidentBytes());
+
+    for (std::size_t i = 0; i < PhaseCount; ++i) {
+        // null when some call of the phase ran on several threads, a partial
+        // sum would look like a complete one
+        const auto calls = m_phaseCalls[i].load();
+        const auto cpuSeconds = m_cpuCalls[i].load() == calls ? fmt::format("{:.6f}", m_cpuNanoseconds[i] * 1e-9) : std::string("null");
+        fmt::format_to(std::back_inserter(json), "    \"{}\": {{ \"wallSeconds\": {:.6f}, \"cpuSeconds\": {}, \"calls\": {} }}{}\n",
+                       PhaseNames[i], m_wallNanoseconds[i] * 1e-9, cpuSeconds, calls,
+                       i + 1 < PhaseCount ? "," : "");
+    }
+
+    json.append("  },\n  \"counters\": {\n");
+    for (std::size_t i = 0; i < CounterCount; ++i) {
+        fmt::format_to(std::back_inserter(json), "    \"{}\": {}{}\n",
+                       CounterNames[i], m_counters[i].load(), i + 1 < CounterCount ? "," : "");
+    }
+    json.append("  }\n}\n");
+
+    OutputBuffer out(fileName);
+    if (!out.isOpen()) {
+        return false;
+    }
+
+    out.write(json);
+    out.close();
+
+    fmt::print("Wrote profile to {}\n", out.fileName());
+    return true;
+}
+
+#if defined(_WIN32)
+
+double Profile::processCpuSeconds()
+{
+    FILETIME creation, exit, kernel, user;
+    if (!GetProcessTimes(GetCurrentProcess(), &creation, &exit, &kernel, &user)) {
+        return 0.0;
+    }
+
+    // 100 nanosecond ticks
+    auto ticks = [](const FILETIME& time) {
+        return (std::uint64_t(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    return (ticks(kernel) + ticks(user)) * 1e-7;
+}
+
+double Profile::threadCpuSeconds()
+{
+    FILETIME creation, exit, kernel, user;
+    if (!GetThreadTimes(GetCurrentThread(), &creation, &exit, &kernel, &user)) {
+        return 0.0;
+    }
+
+    auto ticks = [](const FILETIME& time) {
+        return (std::uint64_t(time.dwHighDateTime) << 32) | time.dwLowDateTime;
+    };
+    return (ticks(kernel) + ticks(user)) * 1e-7;
+}
+
+#else
+
+double Profile::processCpuSeconds()
+{
+    timespec time;
+    if (clock_gettime(CLOCK_PROCESS_CPUTIME_ID, &time) != 0) {
+        return 0.0;
+    }
+
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+double Profile::threadCpuSeconds()
+{
+    timespec time;
+    if (clock_gettime(CLOCK_THREAD_CPUTIME_ID, &time) != 0) {
+        return 0.0;
+    }
+
+    return time.tv_sec + time.tv_nsec * 1e-9;
+}
+
+#endif
+
+} // namespace fbxViz
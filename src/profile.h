@@ -0,0 +1,140 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include <atomic>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace fbxViz {
+
+enum class Phase
+{
+    Initialize,
+    Import,
+    Validate,
+    Flatten,
+    DagTraversal,
+    AnimStackTraversal,
+    Serialize,         // writing the graphs, with --stream it is part of the traversals
+    Sample,            // --sample, evaluating the curves and writing the table
+    MotionBounds,      // --motion-bounds, evaluating the world transforms
+    MeshStats,         // --mesh-stats, reading the meshes
+    Count
+};
+
+// "dagTraversal", the name in the JSON output
+std::string_view phaseName(Phase phase);
+
+enum class Counter
+{
+    Files,
+    CacheHits,
+    Nodes,
+    Edges,
+    Curves,
+    Keys,
+    BytesWritten,
+    Count
+};
+
+// --profile: wall and CPU time per phase, counters and the peak resident
+// memory of the run, written as JSON. Phases and counters can be added from
+// any thread. The CPU time of a phase is that of the thread running it, so
+// phases overlapping on other threads ( --validate=async, batch workers )
+// are not counted twice. Phases handing work to other threads only report
+// their wall time, their cpuSeconds are null. In batch mode the phases of
+// the workers overlap and their times are sums over the workers.
+class Profile final
+{
+public:
+    Profile();
+
+    // delete copy and move
+    Profile(const Profile& other) = delete;
+    Profile& operator=(const Profile& other) = delete;
+    Profile(Profile&& other) = delete;
+    Profile& operator=(Profile&& other) = delete;
+
+    // times a phase over its lifetime, does nothing for a null profile.
+    // measureCpu is false when the phase spreads its work over other
+    // threads, the CPU time of the calling thread would miss it.
+    class Scope final
+    {
+    public:
+        Scope(Profile* profile, Phase phase, bool measureCpu = true);
+        ~Scope();
+
+        // delete copy and move
+        Scope(const Scope& other) = delete;
+        Scope& operator=(const Scope& other) = delete;
+        Scope(Scope&& other) = delete;
+        Scope& operator=(Scope&& other) = delete;
+
+    private:
+        Profile* m_profile;
+        Phase m_phase;
+        bool m_measureCpu;
+        std::chrono::steady_clock::time_point m_wallStart;
+        double m_cpuStart{0.0};
+    };
+
+    // a negative cpuSeconds marks a phase without CPU time
+    void addPhase(Phase phase, double wallSeconds, double cpuSeconds);
+    void count(Counter counter, std::uint64_t value = 1);
+
+    // adds the sizes of the files that exist to Counter::BytesWritten
+    void countFiles(const std::vector<std::string>& fileNames);
+
+    double wallSeconds(Phase phase) const;
+    double cpuSeconds(Phase phase) const;
+    std::uint64_t counter(Counter counter) const;
+
+    bool write(std::string_view fileName, const std::vector<std::string>& inputFiles) const;
+
+    // CPU time of the whole process so far
+    static double processCpuSeconds();
+
+    // CPU time of the calling thread so far
+    static double threadCpuSeconds();
+
+private:
+    static constexpr std::size_t PhaseCount = static_cast<std::size_t>(Phase::Count);
+    static constexpr std::size_t CounterCount = static_cast<std::size_t>(Counter::Count);
+
+    std::chrono::steady_clock::time_point m_wallStart;
+    double m_cpuStart;
+
+    std::atomic<std::uint64_t> m_wallNanoseconds[PhaseCount]{};
+    std::atomic<std::uint64_t> m_cpuNanoseconds[PhaseCount]{};
+    std::atomic<std::uint64_t> m_phaseCalls[PhaseCount]{};
+    std::atomic<std::uint64_t> m_cpuCalls[PhaseCount]{};
+    std::atomic<std::uint64_t> m_counters[CounterCount]{};
+};
+
+} // namespace fbxViz
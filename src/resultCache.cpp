@@ -0,0 +1,235 @@
+#include "resultCache.h"
+#include "hash.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <cstdio>
+#include <memory>
+#include <random>
+#include <thread>
+
+#if defined(_WIN32)
+    #define WIN32_LEAN_AND_MEAN
+    #define NOMINMAX
+    #include <windows.h>
+#else
+    #include <unistd.h>
+#endif
+
+namespace fs = std::filesystem;
+
+namespace {
+
+    std::uint64_t processId()
+    {
+#if defined(_WIN32)
+        return static_cast<std::uint64_t>(GetCurrentProcessId());
+#else
+        return static_cast<std::uint64_t>(getpid());
+#endif
+    }
+
+    // bump when the generated output changes for the same input and options
+    constexpr int CacheVersion = 3;
+
+    bool hashFile(const std::string& fileName, std::uint64_t& digest)
+    {
+        std::unique_ptr<FILE, int (*)(FILE*)> file(std::fopen(fileName.c_str(), "rb"), &std::fclose);
+        if (!file) {
+            return false;
+        }
+
+        fbxViz::ContentHash hash;
+        std::vector<unsigned char> buffer(1 << 20);
+        for (;;) {
+            const auto count = std::fread(buffer.data(), 1, buffer.size(), file.get());
+            hash.update(buffer.data(), count);
+            if (count < buffer.size()) {
+                break;
+            }
+        }
+
+        if (std::ferror(file.get())) {
+            return false;
+        }
+
+        digest = hash.digest();
+        return true;
+    }
+
+    std::string artifactName(std::size_t index)
+    {
+        return fmt::format("{}.dot", index);
+    }
+
+    std::uintmax_t entrySize(const fs::path& entry)
+    {
+        std::error_code ec;
+        std::uintmax_t size = 0;
+        for (fs::directory_iterator it(entry, ec), end; !ec && it != end; it.increment(ec)) {
+            const auto fileSize = it->file_size(ec);
+            size += ec ? 0 : fileSize;
+            ec.clear();
+        }
+
+        return size;
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+ResultCache::ResultCache(const Options& options)
+    : m_directory(options.cacheDir)
+    , m_maxBytes(options.cacheSize)
+{
+    // the redundant key report is printed while the scene is traversed,
+    // a cache hit could not reproduce it
+    if (options.redundantKeys) {
+        m_directory.clear();
+    }
+
+    // the options that change what ends up in the DOT files, and the scene
+    // checks a hit stands in for. Async runs the full checks, both share
+    // their entries.
+    const auto validation = options.validation == ValidationMode::Async ? ValidationMode::Full : options.validation;
+    m_optionsKey = fmt::format("v{} validation={} stream={} format={} compress={} snapshot={} svg={} sample={}:{}:{} motion-bounds={}:{} mesh-stats={} curve-detail={}:{} root={} max-depth={} types={} name-regex={}",
+                               CacheVersion,
+                               static_cast<int>(validation),
+                               options.streaming,
+                               static_cast<int>(options.format),
+                               static_cast<int>(options.compression),
+                               options.snapshot,
+                               options.svg,
+                               options.sample,
+                               options.sampleRate,
+                               static_cast<int>(options.sampleFormat),
+                               options.motionBounds,
+                               options.motionBoundsRate,
+                               options.meshStats,
+                               static_cast<int>(options.curveDetail.mode),
+                               options.curveDetail.maxRows,
+                               options.root,
+                               options.maxDepth,
+                               fmt::join(options.types, ","),
+                               options.nameRegex);
+}
+
+std::string ResultCache::key(const std::string& inputFile) const
+{
+    std::uint64_t contentDigest = 0;
+    if (!hashFile(inputFile, contentDigest)) {
+        return {};
+    }
+
+    ContentHash optionsHash;
+    optionsHash.update(m_optionsKey.data(), m_optionsKey.size());
+
+    return fmt::format("{:016x}{:016x}", contentDigest, optionsHash.digest());
+}
+
+bool ResultCache::fetch(const std::string& key, const std::vector<std::string>& outputFiles) const
+{
+    if (key.empty()) {
+        return false;
+    }
+
+    const auto entry = m_directory / key;
+
+    std::error_code ec;
+    if (!fs::is_directory(entry, ec)) {
+        return false;
+    }
+
+    for (std::size_t i = 0; i < outputFiles.size(); ++i) {
+        fs::copy_file(entry / artifactName(i), outputFiles[i], fs::copy_options::overwrite_existing, ec);
+        if (ec) {
+            return false;
+        }
+    }
+
+    // the entry modification time orders the eviction
+    fs::last_write_time(entry, fs::file_time_type::clock::now(), ec);
+
+    for (const auto& outputFile : outputFiles) {
+        fmt::print("Served {} from cache\n", outputFile);
+    }
+
+    return true;
+}
+
+void ResultCache::store(const std::string& key, const std::vector<std::string>& outputFiles) const
+{
+    if (key.empty()) {
+        return;
+    }
+
+    // written aside and renamed into place, batch workers and processes on
+    // other machines sharing the cache directory may store the same entry at
+    // the same time. Process ids repeat across machines, hence the random
+    // part.
+    const auto entry = m_directory / key;
+    const auto staging = m_directory / fmt::format("{}.{}.{}.{:08x}.tmp", key, processId(), std::hash<std::thread::id>()(std::this_thread::get_id()),
+                                                   std::random_device()());
+
+    std::error_code ec;
+    fs::create_directories(staging, ec);
+    for (std::size_t i = 0; i < outputFiles.size() && !ec; ++i) {
+        fs::copy_file(outputFiles[i], staging / artifactName(i), fs::copy_options::overwrite_existing, ec);
+    }
+
+    if (!ec) {
+        fs::rename(staging, entry, ec);
+    }
+
+    if (ec) {
+        fs::remove_all(staging, ec);
+    }
+}
+
+void ResultCache::evict() const
+{
+    struct Entry
+    {
+        fs::path path;
+        fs::file_time_type lastUse;
+        std::uintmax_t size;
+    };
+
+    std::error_code ec;
+    std::vector<Entry> entries;
+    std::uintmax_t totalSize = 0;
+    for (fs::directory_iterator it(m_directory, ec), end; !ec && it != end; it.increment(ec)) {
+        if (!it->is_directory(ec) || it->path().extension() == ".tmp") {
+            continue;
+        }
+
+        Entry entry{ it->path(), it->last_write_time(ec), entrySize(it->path()) };
+        totalSize += entry.size;
+        entries.push_back(std::move(entry));
+    }
+
+    if (totalSize <= m_maxBytes) {
+        return;
+    }
+
+    std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.lastUse < b.lastUse; });
+
+    std::size_t evicted = 0;
+    for (const auto& entry : entries) {
+        if (totalSize <= m_maxBytes) {
+            break;
+        }
+
+        fs::remove_all(entry.path, ec);
+        if (!ec) {
+            totalSize -= entry.size;
+            ++evicted;
+        }
+    }
+
+    fmt::print("Evicted {} cache entries, {:.2f} MB left\n", evicted, totalSize / (1024.0 * 1024.0));
+}
+
+} // namespace fbxViz
@@ -0,0 +1,62 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "options.h"
+
+#include <cstdint>
+#include <filesystem>
+#include <string>
+#include <vector>
+
+namespace fbxViz {
+
+// on-disk cache of generated DOT files, keyed by a hash of the input file
+// contents and of the options that change the output. A hit copies the
+// cached files to the outputs without touching the FBX SDK. Entries are
+// evicted least recently used first once the cache outgrows its size.
+class ResultCache final
+{
+public:
+    explicit ResultCache(const Options& options);
+
+    bool enabled() const { return !m_directory.empty(); }
+
+    // empty if the input can not be read
+    std::string key(const std::string& inputFile) const;
+
+    // copies the cached files of the entry to outputFiles, in order
+    bool fetch(const std::string& key, const std::vector<std::string>& outputFiles) const;
+    void store(const std::string& key, const std::vector<std::string>& outputFiles) const;
+
+    // removes the oldest entries until the cache fits its size
+    void evict() const;
+
+private:
+    std::filesystem::path m_directory;
+    std::uintmax_t m_maxBytes{0};
+    std::string m_optionsKey;
+};
+
+} // namespace fbxViz
@@ -0,0 +1,278 @@
+#include "sceneDiff.h"
+#include "hash.h"
+
+#include "graph/node.h"
+#include "graph/nodeData.h"
+
+#include <fmt/format.h>
+
+#include <algorithm>
+#include <iterator>
+#include <string_view>
+#include <unordered_map>
+
+namespace {
+
+    using Tree = fbxViz::SceneHashTree;
+
+    // nodes coming from the scene before the change carry another slot, a
+    // removed node and an added one may share their index
+    constexpr std::string_view BeforeSlot = "before";
+    constexpr std::string_view AfterSlot = "after";
+
+    std::size_t curveCount(const Tree& tree, std::uint32_t index)
+    {
+        // the subtree of a pre-order entry is the range that follows it
+        std::size_t count = 0;
+        for (auto i = index; i < index + tree.entries[index].subtreeSize; ++i) {
+            count += tree.entries[i].curves.size();
+        }
+        return count;
+    }
+
+    std::string keyCountInfo(std::uint64_t keyCount)
+    {
+        std::string dataInfo;
+        fbxViz::NodeDataBuilder(dataInfo).row().field("Key counts", keyCount);
+        return dataInfo;
+    }
+
+    class DiffBuilder
+    {
+    public:
+        DiffBuilder(const Tree& before, const Tree& after, fbxViz::GraphSink& graph)
+            : m_before(before), m_after(after), m_graph(graph) {}
+
+        fbxViz::SceneDiffSummary run();
+
+    private:
+        struct Pending
+        {
+            std::uint32_t before;
+            std::uint32_t after;
+            fbxViz::NodeRef parent;
+        };
+
+        fbxViz::NodeRef addNode(const fbxViz::NodeKey& key, std::string_view name, std::string_view change, const std::string& dataInfo);
+        void addEdge(const fbxViz::NodeRef& parent, const fbxViz::NodeRef& child);
+
+        fbxViz::NodeRef comparePair(const Pending& pair);
+        void diffCurves(const Tree::Entry& before, const Tree::Entry& after, std::uint32_t afterIndex, const fbxViz::NodeRef& node);
+        void addCurve(const fbxViz::NodeKey& key, const Tree::Entry& owner, const Tree::Curve& curve, std::string_view change,
+                      const std::string& dataInfo, const fbxViz::NodeRef& node);
+        void matchChildren(const Tree::Entry& before, const Tree::Entry& after, const fbxViz::NodeRef& node);
+        void addSubtree(const Tree& tree, std::uint32_t index, std::string_view slot, std::string_view change, const fbxViz::NodeRef& parent);
+
+        const Tree& m_before;
+        const Tree& m_after;
+        fbxViz::GraphSink& m_graph;
+
+        std::vector<Pending> m_pending;
+        fbxViz::SceneDiffSummary m_summary;
+    };
+
+    fbxViz::SceneDiffSummary DiffBuilder::run()
+    {
+        if (m_before.entries.empty() || m_after.entries.empty()) {
+            return m_summary;
+        }
+
+        // roots are always paired
+        m_pending.push_back({ 0, 0, { fbxViz::InvalidNodeId, {} } });
+        while (!m_pending.empty()) {
+            const auto pair = m_pending.back();
+            m_pending.pop_back();
+
+            ++m_summary.visitedNodes;
+            const auto& before = m_before.entries[pair.before];
+            const auto& after = m_after.entries[pair.after];
+
+            // equal subtrees are never entered
+            if (before.subtreeHash == after.subtreeHash && pair.parent.id != fbxViz::InvalidNodeId) {
+                continue;
+            }
+
+            const auto node = comparePair(pair);
+            if (before.subtreeHash != after.subtreeHash) {
+                matchChildren(before, after, node);
+            }
+        }
+
+        return m_summary;
+    }
+
+    fbxViz::NodeRef DiffBuilder::addNode(const fbxViz::NodeKey& key, std::string_view name, std::string_view change, const std::string& dataInfo)
+    {
+        fbxViz::Node node(name);
+        node.setType(change);
+        node.setDataInfo(dataInfo);
+        return { m_graph.addNode(key, node), name };
+    }
+
+    void DiffBuilder::addEdge(const fbxViz::NodeRef& parent, const fbxViz::NodeRef& child)
+    {
+        if (parent.id != fbxViz::InvalidNodeId) {
+            m_graph.addEdge(parent, child);
+        }
+    }
+
+    fbxViz::NodeRef DiffBuilder::comparePair(const Pending& pair)
+    {
+        const auto& before = m_before.entries[pair.before];
+        const auto& after = m_after.entries[pair.after];
+
+        std::string dataInfo;
+        fbxViz::NodeDataBuilder data(dataInfo);
+        if (before.attributeHash != after.attributeHash) {
+            data.row().field("Attributes Before", before.type).field("Attributes After", after.type);
+        }
+        if (before.transformHash != after.transformHash) {
+            data.row().text("Transform changed");
+        }
+
+        const bool modified = before.localHash != after.localHash;
+        if (modified) {
+            ++m_summary.modifiedNodes;
+        }
+
+        auto node = addNode(fbxViz::NodeKey(pair.after, AfterSlot), after.name, modified ? "modified" : "unchanged", dataInfo);
+        addEdge(pair.parent, node);
+
+        if (before.curvesHash != after.curvesHash) {
+            diffCurves(before, after, pair.after, node);
+        }
+
+        return node;
+    }
+
+    void DiffBuilder::diffCurves(const Tree::Entry& before, const Tree::Entry& after, std::uint32_t afterIndex, const fbxViz::NodeRef& node)
+    {
+        // both lists are sorted by channel
+        auto b = before.curves.begin();
+        auto a = after.curves.begin();
+        while (b != before.curves.end() || a != after.curves.end()) {
+            if (a == after.curves.end() || (b != before.curves.end() && b->channel < a->channel)) {
+                ++m_summary.removedCurves;
+                addCurve(fbxViz::NodeKey(afterIndex, std::string(BeforeSlot) + b->channel), before, *b, "removed",
+                         keyCountInfo(b->keyCount), node);
+                ++b;
+            } else if (b == before.curves.end() || a->channel < b->channel) {
+                ++m_summary.addedCurves;
+                addCurve(fbxViz::NodeKey(afterIndex, std::string(AfterSlot) + a->channel), after, *a, "added",
+                         keyCountInfo(a->keyCount), node);
+                ++a;
+            } else {
+                if (a->hash != b->hash) {
+                    ++m_summary.modifiedCurves;
+                    std::string dataInfo;
+                    fbxViz::NodeDataBuilder(dataInfo).row().field("Key counts Before", b->keyCount).field("Key counts After", a->keyCount);
+                    addCurve(fbxViz::NodeKey(afterIndex, std::string(AfterSlot) + a->channel), after, *a, "modified", dataInfo, node);
+                }
+                ++a;
+                ++b;
+            }
+        }
+    }
+
+    void DiffBuilder::addCurve(const fbxViz::NodeKey& key, const Tree::Entry& owner, const Tree::Curve& curve, std::string_view change,
+                               const std::string& dataInfo, const fbxViz::NodeRef& node)
+    {
+        const auto name = fmt::format("{}_{}_animCurve", owner.name, curve.channel);
+        auto curveNode = addNode(key, name, change, dataInfo);
+        addEdge(node, curveNode);
+    }
+
+    void DiffBuilder::matchChildren(const Tree::Entry& before, const Tree::Entry& after, const fbxViz::NodeRef& node)
+    {
+        // children of the same name pair up in order, pushed in reverse so
+        // they are compared in order
+        const auto firstPending = m_pending.size();
+        std::unordered_map<std::string_view, std::vector<std::uint32_t>> afterByName;
+        for (auto it = after.children.rbegin(); it != after.children.rend(); ++it) {
+            afterByName[m_after.entries[*it].name].push_back(*it);
+        }
+
+        for (auto child : before.children) {
+            auto it = afterByName.find(m_before.entries[child].name);
+            if (it == afterByName.end() || it->second.empty()) {
+                addSubtree(m_before, child, BeforeSlot, "removed", node);
+                continue;
+            }
+
+            const auto afterChild = it->second.back();
+            it->second.pop_back();
+            m_pending.push_back({ child, afterChild, node });
+        }
+        std::reverse(m_pending.begin() + firstPending, m_pending.end());
+
+        // whatever is left over only exists after the change
+        for (auto child : after.children) {
+            auto& candidates = afterByName[m_after.entries[child].name];
+            if (std::find(candidates.begin(), candidates.end(), child) != candidates.end()) {
+                addSubtree(m_after, child, AfterSlot, "added", node);
+            }
+        }
+    }
+
+    void DiffBuilder::addSubtree(const Tree& tree, std::uint32_t index, std::string_view slot, std::string_view change, const fbxViz::NodeRef& parent)
+    {
+        const auto& entry = tree.entries[index];
+        const auto curves = curveCount(tree, index);
+
+        if (change == "added") {
+            m_summary.addedNodes += entry.subtreeSize;
+            m_summary.addedCurves += curves;
+        } else {
+            m_summary.removedNodes += entry.subtreeSize;
+            m_summary.removedCurves += curves;
+        }
+
+        // a whole subtree shows up as its root
+        std::string dataInfo;
+        fbxViz::NodeDataBuilder(dataInfo)
+            .row().text(entry.type)
+            .row().field("Subtree Nodes", entry.subtreeSize).field("Curves", curves);
+
+        const auto name = fmt::format("{}_{}", entry.name, change);
+        auto node = addNode(fbxViz::NodeKey(index, slot), name, change, dataInfo);
+        addEdge(parent, node);
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+void SceneHashTree::finalize()
+{
+    for (auto& entry : entries) {
+        entry.localHash = hashCombine(hashCombine(entry.attributeHash, entry.transformHash), entry.curvesHash);
+    }
+
+    // children follow their parent in pre-order, walking backwards
+    // finishes every subtree before its root
+    for (auto i = entries.size(); i-- > 0;) {
+        auto& entry = entries[i];
+
+        // matching is by name, so the order of the children does not matter
+        std::uint64_t childSum = 0;
+        entry.subtreeSize = 1;
+        for (auto child : entry.children) {
+            childSum += entries[child].subtreeHash;
+            entry.subtreeSize += entries[child].subtreeSize;
+        }
+
+        entry.subtreeHash = hashCombine(hashCombine(entry.localHash, childSum), entry.children.size());
+    }
+}
+
+bool SceneDiffSummary::empty() const
+{
+    return addedNodes + removedNodes + modifiedNodes + addedCurves + removedCurves + modifiedCurves == 0;
+}
+
+SceneDiffSummary diffSceneHashTrees(const SceneHashTree& before, const SceneHashTree& after, GraphSink& graph)
+{
+    return DiffBuilder(before, after, graph).run();
+}
+
+} // namespace fbxViz
@@ -0,0 +1,92 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "graph/graphSink.h"
+
+#include <cstdint>
+#include <string>
+#include <vector>
+
+namespace fbxViz {
+
+// Merkle style hashes of a scene hierarchy. Every node hashes what it
+// carries itself, its subtree hash folds in the subtree hashes of its
+// children, so two equal subtree hashes stand for two equal subtrees.
+struct SceneHashTree
+{
+    struct Curve
+    {
+        std::string channel;    // "stack_layer_channel"
+        std::uint64_t hash{0};  // key times, values, tangents and flags
+        std::size_t keyCount{0};
+    };
+
+    struct Entry
+    {
+        std::string name;
+        std::string type;
+
+        std::uint64_t attributeHash{0}; // name and attribute types
+        std::uint64_t transformHash{0}; // local translation, rotation and scaling
+        std::uint64_t curvesHash{0};
+        std::uint64_t localHash{0};
+        std::uint64_t subtreeHash{0};
+        std::uint32_t subtreeSize{1};
+
+        std::vector<Curve> curves;          // sorted by channel
+        std::vector<std::uint32_t> children;
+    };
+
+    // entries in pre-order, the root first
+    std::vector<Entry> entries;
+
+    // fills the local and subtree hashes once the entries and their
+    // attribute, transform and curve hashes are set
+    void finalize();
+};
+
+struct SceneDiffSummary
+{
+    std::size_t addedNodes{0};
+    std::size_t removedNodes{0};
+    std::size_t modifiedNodes{0};
+    std::size_t addedCurves{0};
+    std::size_t removedCurves{0};
+    std::size_t modifiedCurves{0};
+
+    // node pairs compared, identical subtrees are not entered
+    std::size_t visitedNodes{0};
+
+    bool empty() const;
+};
+
+// adds the delta from `before` to `after` to the graph. Children are
+// matched by name, subtrees with equal hashes are skipped without looking
+// inside, so the work grows with the change and not with the scene.
+// Node types are "added", "removed", "modified" or "unchanged" for the
+// ancestors that only lead to a change.
+SceneDiffSummary diffSceneHashTrees(const SceneHashTree& before, const SceneHashTree& after, GraphSink& graph);
+
+} // namespace fbxViz
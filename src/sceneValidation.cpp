@@ -0,0 +1,72 @@
+#include "sceneValidation.h"
+
+#include <fmt/core.h>
+
+namespace {
+
+    // fast checks the connections for cycles, the empty animation layers
+    // and the other scene data, full adds the per key and per polygon checks
+    // of the data check loadScene() always ran, so fast is a subset of full
+    FbxSceneCheckUtility::ECheckMode checkMode(fbxViz::ValidationMode mode)
+    {
+        const auto fast = FbxSceneCheckUtility::eCheckCycles | FbxSceneCheckUtility::eCheckAnimationEmptyLayers |
+                          FbxSceneCheckUtility::eCheckOtherData;
+        if (mode == fbxViz::ValidationMode::Fast) {
+            return static_cast<FbxSceneCheckUtility::ECheckMode>(fast);
+        }
+
+        return static_cast<FbxSceneCheckUtility::ECheckMode>(fast | FbxSceneCheckUtility::eCkeckData);
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+bool validateScene(FbxScene* pScene, std::string_view fileName, ValidationMode mode, Profile* profile)
+{
+    if (mode == ValidationMode::Off) {
+        return true;
+    }
+
+    Profile::Scope scope(profile, Phase::Validate);
+
+    // check the scene integrity
+    FbxStatus stat;
+    FbxArray<FbxString*> details;
+    FbxSceneCheckUtility sceneCheck(pScene, &stat, &details);
+    const bool status = sceneCheck.Validate(checkMode(mode));
+
+    if (!status || details.GetCount() > 0) {
+        fmt::print("Validation of {} found {} issues:\n", fileName, details.GetCount());
+        for (auto i = 0; i < details.GetCount(); ++i) {
+            fmt::print("  {}\n", details[i]->Buffer());
+        }
+    }
+    FbxArrayDelete(details);
+
+    return status;
+}
+
+BackgroundValidation::BackgroundValidation(FbxScene* pScene, std::string_view fileName, Profile* profile)
+    : m_fileName(fileName)
+{
+    m_thread = std::thread([this, pScene, profile]() {
+        m_passed = validateScene(pScene, m_fileName, ValidationMode::Full, profile);
+    });
+}
+
+BackgroundValidation::~BackgroundValidation()
+{
+    wait();
+}
+
+bool BackgroundValidation::wait()
+{
+    if (m_thread.joinable()) {
+        m_thread.join();
+    }
+
+    return m_passed;
+}
+
+} // namespace fbxViz
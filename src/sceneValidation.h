@@ -0,0 +1,65 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "options.h"
+#include "profile.h"
+
+#include <fbxsdk.h>
+
+#include <string>
+#include <string_view>
+#include <thread>
+
+namespace fbxViz {
+
+// runs the FbxSceneCheckUtility checks of a mode and prints the issues
+// found, true when the scene passed or the mode is off. Async runs the
+// full checks.
+bool validateScene(FbxScene* pScene, std::string_view fileName, ValidationMode mode, Profile* profile = nullptr);
+
+// --validate=async: checks the scene on a background thread while it is
+// dumped. The checks and the traversals only read the scene.
+class BackgroundValidation final
+{
+public:
+    BackgroundValidation(FbxScene* pScene, std::string_view fileName, Profile* profile = nullptr);
+    ~BackgroundValidation();
+
+    // delete copy and move
+    BackgroundValidation(const BackgroundValidation& other) = delete;
+    BackgroundValidation& operator=(const BackgroundValidation& other) = delete;
+    BackgroundValidation(BackgroundValidation&& other) = delete;
+    BackgroundValidation& operator=(BackgroundValidation&& other) = delete;
+
+    // waits for the checks, true when the scene passed
+    bool wait();
+
+private:
+    std::string m_fileName;
+    std::thread m_thread;
+    bool m_passed{false};
+};
+
+} // namespace fbxViz
@@ -0,0 +1,328 @@
+#include "transformEvaluator.h"
+#include "curveInfo.h"
+#include "parallel.h"
+
+#include <algorithm>
+#include <cmath>
+#include <limits>
+
+namespace {
+
+    // frames whose channels are sampled in one pass, a worker keeps that many
+    // values of every curve
+    constexpr std::size_t ChunkFrames = 256;
+
+    constexpr double DegreesToRadians = 3.14159265358979323846 / 180.0;
+
+    // the 3x3 part of a matrix, the rest of the identity around it
+    fbxViz::Matrix4 rotationMatrix(const double r[9])
+    {
+        auto result = fbxViz::Matrix4::identity();
+        for (int column = 0; column < 3; ++column) {
+            for (int row = 0; row < 3; ++row) {
+                result.m[column * 4 + row] = r[column * 3 + row];
+            }
+        }
+        return result;
+    }
+
+    // the rotation about one axis, column-major
+    fbxViz::Matrix4 axisRotation(int axis, double degrees)
+    {
+        const double c = std::cos(degrees * DegreesToRadians);
+        const double s = std::sin(degrees * DegreesToRadians);
+        switch (axis) {
+            case 0: {
+                const double r[9] = { 1, 0, 0, 0, c, s, 0, -s, c };
+                return rotationMatrix(r);
+            }
+            case 1: {
+                const double r[9] = { c, 0, -s, 0, 1, 0, s, 0, c };
+                return rotationMatrix(r);
+            }
+            default: {
+                const double r[9] = { c, s, 0, -s, c, 0, 0, 0, 1 };
+                return rotationMatrix(r);
+            }
+        }
+    }
+
+    // euler angles in degrees. The order names the axes in the order they
+    // apply, XYZ rotates about X first, so R = Rz * Ry * Rx. Spheric XYZ is
+    // evaluated as XYZ, like the SDK does for the local matrices.
+    fbxViz::Matrix4 eulerRotation(const double* degrees, EFbxRotationOrder order)
+    {
+        int axes[3] = { 0, 1, 2 };
+        switch (order) {
+            case eEulerXZY: axes[1] = 2; axes[2] = 1; break;
+            case eEulerYZX: axes[0] = 1; axes[1] = 2; axes[2] = 0; break;
+            case eEulerYXZ: axes[0] = 1; axes[1] = 0; axes[2] = 2; break;
+            case eEulerZXY: axes[0] = 2; axes[1] = 0; axes[2] = 1; break;
+            case eEulerZYX: axes[0] = 2; axes[1] = 1; axes[2] = 0; break;
+            default: break;
+        }
+
+        auto result = fbxViz::Matrix4::identity();
+        for (auto axis : axes) {
+            if (degrees[axis] != 0.0) {
+                result = axisRotation(axis, degrees[axis]) * result;
+            }
+        }
+        return result;
+    }
+
+    // the inverse of a matrix that only rotates
+    fbxViz::Matrix4 transposed(const fbxViz::Matrix4& rotation)
+    {
+        auto result = fbxViz::Matrix4::identity();
+        for (int column = 0; column < 3; ++column) {
+            for (int row = 0; row < 3; ++row) {
+                result.m[column * 4 + row] = rotation.m[row * 4 + column];
+            }
+        }
+        return result;
+    }
+
+    fbxViz::Matrix4 translationMatrix(const FbxDouble3& t, double sign = 1.0)
+    {
+        const double v[3] = { sign * t[0], sign * t[1], sign * t[2] };
+        return fbxViz::Matrix4::translation(v);
+    }
+
+} // namespace
+
+namespace fbxViz {
+
+Matrix4 Matrix4::identity()
+{
+    return { { 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1, 0, 0, 0, 0, 1 } };
+}
+
+Matrix4 Matrix4::translation(const double* t)
+{
+    auto result = identity();
+    result.m[12] = t[0];
+    result.m[13] = t[1];
+    result.m[14] = t[2];
+    return result;
+}
+
+Matrix4 Matrix4::scaling(const double* s)
+{
+    auto result = identity();
+    result.m[0] = s[0];
+    result.m[5] = s[1];
+    result.m[10] = s[2];
+    return result;
+}
+
+Matrix4 Matrix4::operator*(const Matrix4& other) const
+{
+    Matrix4 result;
+    for (int column = 0; column < 4; ++column) {
+        const double* b = other.m + column * 4;
+        for (int row = 0; row < 3; ++row) {
+            result.m[column * 4 + row] = m[row] * b[0] + m[4 + row] * b[1] + m[8 + row] * b[2];
+        }
+        result.m[column * 4 + 3] = column == 3 ? 1.0 : 0.0;
+    }
+
+    // the translation column of other has a 1 at the bottom
+    for (int row = 0; row < 3; ++row) {
+        result.m[12 + row] += m[12 + row];
+    }
+    return result;
+}
+
+double MotionBounds::extent() const
+{
+    double squared = 0.0;
+    for (int axis = 0; axis < 3; ++axis) {
+        if (max[axis] < min[axis]) {
+            return 0.0;
+        }
+        squared += (max[axis] - min[axis]) * (max[axis] - min[axis]);
+    }
+    return std::sqrt(squared);
+}
+
+TransformEvaluator::TransformEvaluator(const FlatScene& scene, FbxAnimLayer* animLayer)
+    : m_nodes(scene.size())
+    , m_parents(scene.size())
+{
+    const char* components[3] = { FBXSDK_CURVENODE_COMPONENT_X, FBXSDK_CURVENODE_COMPONENT_Y, FBXSDK_CURVENODE_COMPONENT_Z };
+
+    for (FlatScene::Index i = 0; i < scene.size(); ++i) {
+        FbxNode* pNode = scene.node(i);
+        auto& node = m_nodes[i];
+        m_parents[i] = scene.parent(i);
+
+        FbxPropertyT<FbxDouble3>* properties[3] = { &pNode->LclTranslation, &pNode->LclRotation, &pNode->LclScaling };
+        node.animated = false;
+        for (std::size_t p = 0; p < 3; ++p) {
+            const auto value = properties[p]->Get();
+            for (std::size_t c = 0; c < 3; ++c) {
+                const auto channel = p * 3 + c;
+                node.values[channel] = value[static_cast<int>(c)];
+                node.curves[channel] = Static;
+
+                FbxAnimCurve* curve = animLayer ? properties[p]->GetCurve(animLayer, components[c]) : nullptr;
+                if (curve) {
+                    node.curves[channel] = static_cast<std::uint32_t>(m_curves.size());
+                    m_curves.push_back(extractCurve(curve));
+                    node.animated = true;
+                }
+            }
+        }
+
+        FbxTransform::EInheritType inheritType;
+        pNode->GetTransformationInheritType(inheritType);
+        node.undoParentScaling = inheritType == FbxTransform::eInheritRrs;
+        if (inheritType == FbxTransform::eInheritRrSs) {
+            ++m_approximatedCount;
+        }
+
+        // the rotation order and the pre and post rotations only count when
+        // the rotation is active
+        const bool rotationActive = pNode->RotationActive.Get();
+        node.rotationOrder = rotationActive ? pNode->RotationOrder.Get() : eEulerXYZ;
+
+        const auto rotationPivot = pNode->RotationPivot.Get();
+        const auto scalingPivot = pNode->ScalingPivot.Get();
+        node.scalingPivot = { scalingPivot[0], scalingPivot[1], scalingPivot[2] };
+
+        auto preRotation = Matrix4::identity();
+        auto postRotation = Matrix4::identity();
+        if (rotationActive) {
+            preRotation = eulerRotation(pNode->PreRotation.Get().mData, eEulerXYZ);
+            postRotation = transposed(eulerRotation(pNode->PostRotation.Get().mData, eEulerXYZ));
+        }
+
+        node.beforeRotation = translationMatrix(pNode->RotationOffset.Get()) * translationMatrix(rotationPivot) * preRotation;
+        node.afterRotation = postRotation * translationMatrix(rotationPivot, -1.0) * translationMatrix(pNode->ScalingOffset.Get())
+                             * translationMatrix(scalingPivot);
+
+        node.local = localTransform(node, node.values.data());
+    }
+}
+
+Matrix4 TransformEvaluator::localTransform(const NodeTransform& node, const double* values) const
+{
+    const double inverseScalingPivot[3] = { -node.scalingPivot[0], -node.scalingPivot[1], -node.scalingPivot[2] };
+
+    return Matrix4::translation(values) * node.beforeRotation * eulerRotation(values + 3, node.rotationOrder)
+           * node.afterRotation * Matrix4::scaling(values + 6) * Matrix4::translation(inverseScalingPivot);
+}
+
+void TransformEvaluator::evaluate(const SampleGrid& grid, unsigned jobs, const FrameVisitor& visit) const
+{
+    const auto frameCount = grid.frameCount();
+    if (frameCount == 0 || m_nodes.empty()) {
+        return;
+    }
+
+    const auto workers = static_cast<std::size_t>(std::min<std::size_t>(workerCount(jobs), frameCount));
+    const auto framesPerWorker = (frameCount + workers - 1) / workers;
+
+    // one contiguous range of frames per worker, its curve cursors only
+    // ever move forward
+    parallelFor(workers, static_cast<unsigned>(workers), [&](std::size_t worker) {
+        const auto first = worker * framesPerWorker;
+        const auto last = std::min(frameCount, first + framesPerWorker);
+        if (first >= last) {
+            return;
+        }
+
+        const auto stride = std::min(ChunkFrames, last - first);
+        std::vector<std::int64_t> times(stride);
+        std::vector<float> samples(m_curves.size() * stride);
+        std::vector<std::size_t> cursors(m_curves.size(), 0);
+        std::vector<Matrix4> world(m_nodes.size());
+
+        for (auto chunk = first; chunk < last; chunk += stride) {
+            const auto chunkFrames = std::min(stride, last - chunk);
+            for (std::size_t frame = 0; frame < chunkFrames; ++frame) {
+                times[frame] = grid.time(chunk + frame);
+            }
+            for (std::size_t curve = 0; curve < m_curves.size(); ++curve) {
+                sampleCurve(m_curves[curve], times.data(), chunkFrames, samples.data() + curve * stride, cursors[curve]);
+            }
+
+            // the channel values of a node at the frame of the chunk
+            auto gather = [&](const NodeTransform& node, std::size_t frame, double* values) {
+                for (std::size_t channel = 0; channel < ChannelCount; ++channel) {
+                    const auto curve = node.curves[channel];
+                    values[channel] = curve == Static ? node.values[channel] : samples[curve * stride + frame];
+                }
+            };
+
+            for (std::size_t frame = 0; frame < chunkFrames; ++frame) {
+                // pre-order, every parent is done before its children
+                double values[ChannelCount];
+                for (std::size_t i = 0; i < m_nodes.size(); ++i) {
+                    const auto& node = m_nodes[i];
+
+                    Matrix4 local = node.local;
+                    if (node.animated) {
+                        gather(node, frame, values);
+                        local = localTransform(node, values);
+                    }
+
+                    const auto parent = m_parents[i];
+                    if (parent == FlatScene::None) {
+                        world[i] = local;
+                        continue;
+                    }
+
+                    if (node.undoParentScaling) {
+                        gather(m_nodes[parent], frame, values);
+                        double inverse[3];
+                        for (int axis = 0; axis < 3; ++axis) {
+                            const auto scale = values[6 + axis];
+                            inverse[axis] = scale != 0.0 ? 1.0 / scale : 0.0;
+                        }
+                        world[i] = world[parent] * Matrix4::scaling(inverse) * local;
+                    } else {
+                        world[i] = world[parent] * local;
+                    }
+                }
+
+                visit(worker, chunk + frame, world.data());
+            }
+        }
+    });
+}
+
+std::vector<MotionBounds> TransformEvaluator::motionBounds(const SampleGrid& grid, unsigned jobs) const
+{
+    constexpr double Infinity = std::numeric_limits<double>::infinity();
+    const MotionBounds empty{ { Infinity, Infinity, Infinity }, { -Infinity, -Infinity, -Infinity } };
+
+    // one set of boxes per worker, merged once all frames are done
+    std::vector<std::vector<MotionBounds>> workerBounds(workerCount(jobs), std::vector<MotionBounds>(m_nodes.size(), empty));
+
+    evaluate(grid, jobs, [&](std::size_t worker, std::size_t, const Matrix4* world) {
+        auto& bounds = workerBounds[worker];
+        for (std::size_t i = 0; i < bounds.size(); ++i) {
+            const auto* t = world[i].translationPart();
+            for (int axis = 0; axis < 3; ++axis) {
+                bounds[i].min[axis] = std::min(bounds[i].min[axis], t[axis]);
+                bounds[i].max[axis] = std::max(bounds[i].max[axis], t[axis]);
+            }
+        }
+    });
+
+    auto bounds = std::move(workerBounds.front());
+    for (std::size_t w = 1; w < workerBounds.size(); ++w) {
+        for (std::size_t i = 0; i < bounds.size(); ++i) {
+            for (int axis = 0; axis < 3; ++axis) {
+                bounds[i].min[axis] = std::min(bounds[i].min[axis], workerBounds[w][i].min[axis]);
+                bounds[i].max[axis] = std::max(bounds[i].max[axis], workerBounds[w][i].max[axis]);
+            }
+        }
+    }
+
+    return bounds;
+}
+
+} // namespace fbxViz
@@ -0,0 +1,140 @@
+// Copyright (C) 2022 Hamed Sabri
+//
+// All rights reserved.
+//
+// Redistribution and use in source and binary forms, with or without modification,
+// are permitted provided that the following conditions are met:
+//
+// 1. Redistributions of source code must retain the above copyright notice, this
+// list of conditions and the following disclaimer.
+// 2. Redistributions in binary form must reproduce the above copyright notice,
+// this list of conditions and the following disclaimer in the documentation
+// and/or other materials provided with the distribution.
+//
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS" AND
+// ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE IMPLIED
+// WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE ARE
+// DISCLAIMED. IN NO EVENT SHALL THE COPYRIGHT HOLDER OR CONTRIBUTORS BE LIABLE FOR
+// ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, EXEMPLARY, OR CONSEQUENTIAL DAMAGES
+// (INCLUDING, BUT NOT LIMITED TO, PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES;
+// LOSS OF USE, DATA, OR PROFITS; OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND
+// ON ANY THEORY OF LIABILITY, WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT
+// (INCLUDING NEGLIGENCE OR OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS
+// SOFTWARE, EVEN IF ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+#pragma once
+
+#include "curveSampler.h"
+#include "curveSnapshot.h"
+#include "flatScene.h"
+
+#include <fbxsdk.h>
+
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <functional>
+#include <vector>
+
+namespace fbxViz {
+
+// affine 4x4 matrix for column vectors, stored column by column with the
+// translation in m[12..14], the memory layout of FbxAMatrix
+struct Matrix4
+{
+    double m[16];
+
+    static Matrix4 identity();
+    static Matrix4 translation(const double* t);
+    static Matrix4 scaling(const double* s);
+
+    // the bottom row is taken as ( 0, 0, 0, 1 )
+    Matrix4 operator*(const Matrix4& other) const;
+
+    const double* translationPart() const { return m + 12; }
+};
+
+// where a node went over the evaluated frames, the box of its world space
+// origin
+struct MotionBounds
+{
+    double min[3];
+    double max[3];
+
+    // the diagonal of the box, 0 for a node that never moves
+    double extent() const;
+};
+
+// world transforms of every node of a flattened scene at any number of
+// frames. The constructor reads the transform properties of the nodes and
+// extracts the translation, rotation and scaling curves of one animation
+// layer once. Evaluating a frame then walks the hierarchy top-down in
+// pre-order, each world matrix built from the one of its parent, without
+// touching the FBX SDK, so frames are evaluated in parallel.
+//
+// Local transforms follow the FBX formula
+//   T * Roff * Rp * Rpre * R * Rpost^-1 * Rp^-1 * Soff * Sp * S * Sp^-1
+// with the rotation order and the pre and post rotations applied when
+// RotationActive is set. The Rrs inheritance undoes the local scaling of the
+// parent, RrSs is evaluated like the default RSrs. Other animation layers
+// are not blended in and the curves are evaluated like sampleCurve() does.
+class TransformEvaluator final
+{
+public:
+    // a null layer evaluates the static transforms
+    TransformEvaluator(const FlatScene& scene, FbxAnimLayer* animLayer);
+
+    // delete copy and move
+    TransformEvaluator(const TransformEvaluator& other) = delete;
+    TransformEvaluator& operator=(const TransformEvaluator& other) = delete;
+    TransformEvaluator(TransformEvaluator&& other) = delete;
+    TransformEvaluator& operator=(TransformEvaluator&& other) = delete;
+
+    // the extracted curves, for the time span of the evaluation
+    const std::vector<CurveSnapshot>& curves() const { return m_curves; }
+
+    // nodes using the RrSs inheritance, evaluated as RSrs
+    std::size_t approximatedCount() const { return m_approximatedCount; }
+
+    // calls visit(worker, frame, world) for every frame of the grid, world
+    // holding the matrix of every node by FlatScene index. The frames are
+    // split into one contiguous range per worker, a worker visits its frames
+    // in order and worker is below workerCount(jobs).
+    using FrameVisitor = std::function<void(std::size_t worker, std::size_t frame, const Matrix4* world)>;
+    void evaluate(const SampleGrid& grid, unsigned jobs, const FrameVisitor& visit) const;
+
+    // the motion bounds of every node over the frames of the grid, by
+    // FlatScene index
+    std::vector<MotionBounds> motionBounds(const SampleGrid& grid, unsigned jobs) const;
+
+private:
+    // the channels of a node in the order translation, rotation, scaling
+    static constexpr std::size_t ChannelCount = 9;
+    static constexpr std::uint32_t Static = ~std::uint32_t(0);
+
+    struct NodeTransform
+    {
+        // property values, replaced by the curves of the animated channels
+        std::array<double, ChannelCount> values;
+        std::array<std::uint32_t, ChannelCount> curves;
+        bool animated;
+        bool undoParentScaling;
+        EFbxRotationOrder rotationOrder;
+
+        // Roff * Rp * Rpre and Rpost^-1 * Rp^-1 * Soff * Sp
+        Matrix4 beforeRotation;
+        Matrix4 afterRotation;
+        std::array<double, 3> scalingPivot;
+
+        // the whole local transform of a node without animated channels
+        Matrix4 local;
+    };
+
+    Matrix4 localTransform(const NodeTransform& node, const double* values) const;
+
+    std::vector<NodeTransform> m_nodes;
+    std::vector<FlatScene::Index> m_parents;
+    std::vector<CurveSnapshot> m_curves;
+    std::size_t m_approximatedCount{0};
+};
+
+} // namespace fbxViz